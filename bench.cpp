@@ -0,0 +1,456 @@
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <poll.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "include/read_amalfi.h"
+#include "include/index_type.h"
+#include "include/simple_adjacency_list.h"
+#include "include/predefined.h"
+#include "include/search_statistics.h"
+#include "include/solution_counter.h"
+
+// Runs every selected predefined.h algorithm on every pattern/target pair,
+// each repetition in its own child process so that a timeout can kill it
+// and peak RSS is per run. A forked child starts out with the parent's
+// whole resident set, the loaded graphs included, so peak_rss_kb is the
+// growth of the child's high-water mark over its resident set at the
+// start of the run: what the search itself allocates and touches, without
+// the pattern and target it is given or anything else the parent holds.
+//
+//   bench -p patterns.txt -t targets.txt [-a alg,alg,...] [-r repetitions]
+//         [-T timeout_seconds] [-j threads] [-w word_bits] [-f csv|json]
+//
+// The list files hold one AMALFI path per line. Exits with 1 if two
+// algorithms for the same problem (monomorphism or induced) that finished
+// report different solution counts for a pair.
+
+using bench_clock = std::chrono::steady_clock;
+
+// when the root node was reached; everything before it is preprocessing
+static bench_clock::time_point root_time;
+
+// Counts nodes and solutions only, so that wall time is not skewed by the
+// phase timers of collect_statistics.
+class bench_statistics : public no_statistics {
+ private:
+  search_statistics stats;
+
+ public:
+  void node(std::size_t depth) {
+    if (depth == 0) {
+      root_time = bench_clock::now();
+    }
+    if (stats.nodes_per_depth.size() <= depth) {
+      stats.nodes_per_depth.resize(depth+1);
+    }
+    ++stats.nodes_per_depth[depth];
+  }
+  void solution() {
+    ++stats.solutions;
+  }
+
+  search_statistics const & report() const {
+    return stats;
+  }
+};
+
+template <typename Index>
+struct algorithm {
+  using graph_type = simple_adjacency_list<Index>;
+
+  char const * name;
+  search_statistics (*run)(graph_type const &, graph_type const &, std::atomic<std::uint64_t> &, unsigned);
+};
+
+#define ALGORITHM(f) \
+  {#f, [](graph_type const & g, graph_type const & h, std::atomic<std::uint64_t> & count, unsigned num_threads) { \
+    return f<bench_statistics>( \
+        g, \
+        h, \
+        solution_counter<>{count}, \
+        [](auto x, auto y) {return true;}, \
+        [](auto x0, auto x1, auto y0, auto y1) {return true;}, \
+        num_threads); \
+  }}
+
+template <typename Index>
+std::vector<algorithm<Index>> const & algorithms() {
+  using graph_type = typename algorithm<Index>::graph_type;
+  static std::vector<algorithm<Index>> const all{
+    ALGORITHM(ullmann_mono),
+    ALGORITHM(ullmann_worklist_mono),
+    ALGORITHM(ullmann_ind),
+    ALGORITHM(ullmann_worklist_ind),
+    ALGORITHM(ullmann_mono_RDEG_CNC),
+    ALGORITHM(ullmann_ind_RDEG_CNC),
+    ALGORITHM(ullmann_oalwna_mono),
+    ALGORITHM(neighborhood_filter_ind),
+    ALGORITHM(ullimp_ind),
+    ALGORITHM(ullimp_worklist_ind),
+    ALGORITHM(ullimp_alldifferent_ind),
+    ALGORITHM(ullimp_bit_mono),
+    ALGORITHM(ullimp_bit_ind),
+    ALGORITHM(ullimp_no_after_ind),
+    ALGORITHM(ullimp2_ind),
+    ALGORITHM(ullimp3_ind),
+    ALGORITHM(ullimp4_mono),
+    ALGORITHM(ullimp4_ind),
+    ALGORITHM(ullimp4_ind2),
+    ALGORITHM(simple_mono),
+    ALGORITHM(simple_ind),
+    ALGORITHM(simple_ind2),
+    ALGORITHM(simple_ind3),
+    ALGORITHM(ri_ind),
+    ALGORITHM(ri_sparse_ind),
+    ALGORITHM(ri_RDEG_CNC_ind),
+    ALGORITHM(ri_RDEG_ind),
+    ALGORITHM(ri_lookahead_ind),
+    ALGORITHM(refined_ri_ind),
+    ALGORITHM(ri_dynamic_parent_ind),
+    ALGORITHM(ri2_ind),
+    ALGORITHM(ri2_sparse_ind),
+    ALGORITHM(ri2_ind2),
+    ALGORITHM(ullimp_ri_ind),
+    ALGORITHM(ullimp_ri_worklist_ind),
+    ALGORITHM(dynamic_ind),
+    ALGORITHM(dynamic_sorted_vector_ind),
+    ALGORITHM(dynamic_mat_ind),
+    ALGORITHM(dynamic_mat_alldifferent_ind),
+    ALGORITHM(dynamic_mat_orderable_ind),
+    ALGORITHM(dynamic_mat_orderable_with_ri_degree_ind),
+    ALGORITHM(dynamic_sorted_vector_new_ind),
+    ALGORITHM(dynamic_linked_mat_orderable_ind),
+    ALGORITHM(dynamic_mat_pushable_ind),
+  };
+  return all;
+}
+
+#undef ALGORITHM
+
+struct options {
+  std::vector<std::string> patterns;
+  std::vector<std::string> targets;
+  std::vector<std::string> algorithms;
+  unsigned repetitions = 1;
+  double timeout = 0;
+  unsigned num_threads = 1;
+  unsigned word_bits = 16;
+  bool json = false;
+};
+
+// what a child reports back through its pipe
+struct measurement {
+  std::int64_t wall_ns;
+  std::int64_t preprocessing_ns;
+  std::uint64_t nodes;
+  std::uint64_t solutions;
+  long peak_rss_kb;
+};
+
+struct result {
+  std::string pattern;
+  std::string target;
+  std::string algorithm;
+  unsigned repetition;
+  char const * status;
+  measurement m;
+};
+
+std::vector<std::string> read_list(char const * filename) {
+  std::ifstream in{filename};
+  if (!in) {
+    std::cerr << "cannot open " << filename << std::endl;
+    std::exit(2);
+  }
+  std::vector<std::string> paths;
+  for (std::string line; std::getline(in, line);) {
+    if (!line.empty()) {
+      paths.push_back(line);
+    }
+  }
+  return paths;
+}
+
+std::vector<std::string> split(std::string const & s, char sep) {
+  std::vector<std::string> parts;
+  std::istringstream in{s};
+  for (std::string part; std::getline(in, part, sep);) {
+    if (!part.empty()) {
+      parts.push_back(part);
+    }
+  }
+  return parts;
+}
+
+template <typename Word>
+std::uint64_t num_vertices(std::string const & filename) {
+  std::ifstream in{filename, std::ios::in|std::ios::binary};
+  return read_word<Word>(in);
+}
+
+template <
+    typename Index,
+    typename Word>
+simple_adjacency_list<Index> load(std::string const & filename) {
+  std::ifstream in{filename, std::ios::in|std::ios::binary};
+  return read_amalfi<simple_adjacency_list<Index>, Word>(in);
+}
+
+// Resets VmHWM to the current resident set; false if the kernel does not
+// allow it.
+bool reset_peak_rss() {
+  std::ofstream out{"/proc/self/clear_refs"};
+  out << "5" << std::flush;
+  return static_cast<bool>(out);
+}
+
+// the kB value of a line of /proc/self/status such as "VmHWM:", or -1 if
+// there is no such line
+long read_status_kb(char const * key) {
+  auto len = std::strlen(key);
+  std::ifstream in{"/proc/self/status"};
+  for (std::string line; std::getline(in, line);) {
+    if (line.compare(0, len, key) == 0) {
+      return std::strtol(line.c_str() + len, nullptr, 10);
+    }
+  }
+  return -1;
+}
+
+long max_rss() {
+  rusage usage;
+  ::getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+// Forks, runs a on (g, h) in the child and waits at most timeout seconds.
+template <typename Index>
+char const * run_isolated(
+    algorithm<Index> const & a,
+    simple_adjacency_list<Index> const & g,
+    simple_adjacency_list<Index> const & h,
+    options const & opt,
+    measurement & m) {
+  int fds[2];
+  if (::pipe(fds) < 0) {
+    return "error";
+  }
+  std::cout.flush();
+  pid_t pid = ::fork();
+  if (pid < 0) {
+    ::close(fds[0]);
+    ::close(fds[1]);
+    return "error";
+  }
+  if (pid == 0) {
+    ::close(fds[0]);
+    std::atomic<std::uint64_t> count{0};
+    // the child shares every resident page of the parent, graphs included;
+    // measure the peak against what is resident right after the reset, or
+    // against ru_maxrss where clear_refs is not allowed
+    bool reset = reset_peak_rss();
+    long base_rss = reset ? read_status_kb("VmRSS:") : -1;
+    if (base_rss < 0) {
+      reset = false;
+      base_rss = max_rss();
+    }
+    auto start = bench_clock::now();
+    root_time = start;
+    auto stats = a.run(g, h, count, opt.num_threads);
+    auto end = bench_clock::now();
+    long peak_rss = reset ? read_status_kb("VmHWM:") : -1;
+    peak_rss = peak_rss < 0 ? max_rss() - base_rss : peak_rss - base_rss;
+    measurement r{
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count(),
+        std::chrono::duration_cast<std::chrono::nanoseconds>(root_time - start).count(),
+        stats.nodes(),
+        count,
+        peak_rss};
+    auto written = ::write(fds[1], &r, sizeof(r));
+    ::_exit(written == sizeof(r) ? 0 : 1);
+  }
+  ::close(fds[1]);
+
+  pollfd p{fds[0], POLLIN, 0};
+  int ready = ::poll(&p, 1, opt.timeout > 0 ? static_cast<int>(opt.timeout*1000) : -1);
+  char const * status = "ok";
+  if (ready == 0) {
+    ::kill(pid, SIGKILL);
+    status = "timeout";
+  } else if (::read(fds[0], &m, sizeof(m)) != sizeof(m)) {
+    status = "error";
+  }
+  ::close(fds[0]);
+  int wstatus;
+  ::waitpid(pid, &wstatus, 0);
+  return status;
+}
+
+template <
+    typename Index,
+    typename Word>
+void run_pair(
+    std::string const & pattern,
+    std::string const & target,
+    options const & opt,
+    std::vector<result> & results) {
+  auto g = load<Index, Word>(pattern);
+  auto h = load<Index, Word>(target);
+  for (auto const & a : algorithms<Index>()) {
+    if (!opt.algorithms.empty() &&
+        std::find(std::begin(opt.algorithms), std::end(opt.algorithms), a.name) == std::end(opt.algorithms)) {
+      continue;
+    }
+    for (unsigned rep=0; rep<opt.repetitions; ++rep) {
+      result r{pattern, target, a.name, rep, nullptr, {}};
+      r.status = run_isolated(a, g, h, opt, r.m);
+      results.push_back(r);
+      std::cerr << pattern << " " << target << " " << a.name << " #" << rep << ": " << r.status << std::endl;
+      if (r.status != std::string("ok")) {
+        break;
+      }
+    }
+  }
+}
+
+template <typename Word>
+void run_all(options const & opt, std::vector<result> & results) {
+  for (auto const & pattern : opt.patterns) {
+    for (auto const & target : opt.targets) {
+      auto n = std::max(num_vertices<Word>(pattern), num_vertices<Word>(target));
+      with_index_type(n, [&](auto index) {
+        run_pair<decltype(index), Word>(pattern, target, opt, results);
+      });
+    }
+  }
+}
+
+void write_csv(std::ostream & out, std::vector<result> const & results) {
+  out << "pattern,target,algorithm,repetition,status,wall_ms,preprocessing_ms,nodes,solutions,peak_rss_kb\n";
+  for (auto const & r : results) {
+    out << r.pattern << "," << r.target << "," << r.algorithm << "," << r.repetition << "," << r.status;
+    if (r.status == std::string("ok")) {
+      out << "," << r.m.wall_ns/1e6 << "," << r.m.preprocessing_ns/1e6 << "," << r.m.nodes << "," << r.m.solutions << "," << r.m.peak_rss_kb;
+    } else {
+      out << ",,,,,";
+    }
+    out << "\n";
+  }
+}
+
+void write_json(std::ostream & out, std::vector<result> const & results) {
+  out << "[";
+  for (std::size_t k=0; k<results.size(); ++k) {
+    auto const & r = results[k];
+    out << (k ? ",\n " : "\n ")
+        << "{\"pattern\":\"" << r.pattern << "\""
+        << ",\"target\":\"" << r.target << "\""
+        << ",\"algorithm\":\"" << r.algorithm << "\""
+        << ",\"repetition\":" << r.repetition
+        << ",\"status\":\"" << r.status << "\"";
+    if (r.status == std::string("ok")) {
+      out << ",\"wall_ms\":" << r.m.wall_ns/1e6
+          << ",\"preprocessing_ms\":" << r.m.preprocessing_ns/1e6
+          << ",\"nodes\":" << r.m.nodes
+          << ",\"solutions\":" << r.m.solutions
+          << ",\"peak_rss_kb\":" << r.m.peak_rss_kb;
+    }
+    out << "}";
+  }
+  out << "\n]\n";
+}
+
+// monomorphism and induced variants count different things
+std::string problem_of(std::string const & algorithm) {
+  return algorithm.find("_mono") != std::string::npos ? "mono" : "ind";
+}
+
+// reports every pair on which two finished runs of the same problem disagree
+bool check_agreement(std::vector<result> const & results) {
+  std::map<std::tuple<std::string, std::string, std::string>, result const *> first;
+  bool agree = true;
+  for (auto const & r : results) {
+    if (r.status != std::string("ok")) {
+      continue;
+    }
+    auto ins = first.emplace(std::make_tuple(r.pattern, r.target, problem_of(r.algorithm)), &r);
+    auto const & f = *ins.first->second;
+    if (f.m.solutions != r.m.solutions) {
+      std::cerr << "MISMATCH " << r.pattern << " " << r.target << ": "
+          << f.algorithm << "=" << f.m.solutions << " "
+          << r.algorithm << "=" << r.m.solutions << std::endl;
+      agree = false;
+    }
+  }
+  return agree;
+}
+
+int main(int argc, char * argv[]) {
+  options opt;
+  for (int k=1; k<argc; ++k) {
+    auto arg = [&]() {
+      if (k+1 >= argc) {
+        std::cerr << "missing value for " << argv[k] << std::endl;
+        std::exit(2);
+      }
+      return argv[++k];
+    };
+    if (!std::strcmp(argv[k], "-p")) {
+      opt.patterns = read_list(arg());
+    } else if (!std::strcmp(argv[k], "-t")) {
+      opt.targets = read_list(arg());
+    } else if (!std::strcmp(argv[k], "-a")) {
+      opt.algorithms = split(arg(), ',');
+    } else if (!std::strcmp(argv[k], "-r")) {
+      opt.repetitions = std::atoi(arg());
+    } else if (!std::strcmp(argv[k], "-T")) {
+      opt.timeout = std::atof(arg());
+    } else if (!std::strcmp(argv[k], "-j")) {
+      opt.num_threads = std::atoi(arg());
+    } else if (!std::strcmp(argv[k], "-w")) {
+      opt.word_bits = std::atoi(arg());
+    } else if (!std::strcmp(argv[k], "-f")) {
+      opt.json = !std::strcmp(arg(), "json");
+    } else {
+      std::cerr << "unknown option " << argv[k] << std::endl;
+      return 2;
+    }
+  }
+  for (auto const & name : opt.algorithms) {
+    auto const & all = algorithms<std::uint16_t>();
+    if (std::none_of(std::begin(all), std::end(all), [&](auto const & a) {return name == a.name;})) {
+      std::cerr << "unknown algorithm " << name << std::endl;
+      return 2;
+    }
+  }
+
+  std::vector<result> results;
+  if (opt.word_bits == 32) {
+    run_all<std::uint32_t>(opt, results);
+  } else {
+    run_all<std::uint16_t>(opt, results);
+  }
+
+  if (opt.json) {
+    write_json(std::cout, results);
+  } else {
+    write_csv(std::cout, results);
+  }
+  return check_agreement(results) ? 0 : 1;
+}
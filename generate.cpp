@@ -0,0 +1,103 @@
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+
+#include "include/read_amalfi.h"
+#include "include/write_amalfi.h"
+#include "include/simple_adjacency_list.h"
+#include "include/graph_generators.h"
+
+// Writes one synthetic graph as AMALFI.
+//
+//   generate [-s seed] [-w word_bits] [-d] -o out.gr MODEL ARGS...
+//
+//   er n p                       Erdos-Renyi G(n, p), directed with -d
+//   ba n m                       Barabasi-Albert, m edges per new vertex
+//   mesh2d w h                   2D grid
+//   mesh3d w h d                 3D grid
+//   bv n valence                 bounded valence
+//   pattern target.gr k ind|mono [keep]
+//                                connected k-vertex pattern of target.gr,
+//                                induced or monomorphic (non-tree arcs kept
+//                                with probability keep)
+//
+// The same seed and arguments always give the same file.
+
+using graph_type = simple_adjacency_list<std::uint32_t>;
+
+template <typename Word>
+int write(char const * filename, graph_type const & g) {
+  if (g.num_vertices() > std::numeric_limits<Word>::max()) {
+    std::cerr << g.num_vertices() << " vertices do not fit " << 8*sizeof(Word) << "-bit words" << std::endl;
+    return 1;
+  }
+  std::ofstream out{filename, std::ios::out|std::ios::binary};
+  write_amalfi<Word>(out, g);
+  return out ? 0 : 1;
+}
+
+int main(int argc, char * argv[]) {
+  std::uint64_t seed = 0;
+  unsigned word_bits = 16;
+  bool directed = false;
+  char const * filename = nullptr;
+  int k = 1;
+  for (; k<argc && argv[k][0] == '-'; ++k) {
+    if (!std::strcmp(argv[k], "-d")) {
+      directed = true;
+    } else if (k+1 < argc && !std::strcmp(argv[k], "-s")) {
+      seed = std::strtoull(argv[++k], nullptr, 10);
+    } else if (k+1 < argc && !std::strcmp(argv[k], "-w")) {
+      word_bits = std::atoi(argv[++k]);
+    } else if (k+1 < argc && !std::strcmp(argv[k], "-o")) {
+      filename = argv[++k];
+    } else {
+      std::cerr << "unknown option " << argv[k] << std::endl;
+      return 2;
+    }
+  }
+  if (filename == nullptr || k >= argc) {
+    std::cerr << "usage: generate [-s seed] [-w word_bits] [-d] -o out.gr MODEL ARGS..." << std::endl;
+    return 2;
+  }
+
+  std::string model = argv[k++];
+  int num_args = argc - k;
+  auto arg = [&](int i) {
+    return std::strtoull(argv[k+i], nullptr, 10);
+  };
+
+  generator_rng rng{seed};
+  auto g = [&]() -> graph_type {
+    if (model == "er" && num_args == 2) {
+      return erdos_renyi<graph_type>(arg(0), std::atof(argv[k+1]), rng, directed);
+    } else if (model == "ba" && num_args == 2) {
+      return barabasi_albert<graph_type>(arg(0), arg(1), rng);
+    } else if (model == "mesh2d" && num_args == 2) {
+      return mesh<graph_type>(arg(0), arg(1));
+    } else if (model == "mesh3d" && num_args == 3) {
+      return mesh<graph_type>(arg(0), arg(1), arg(2));
+    } else if (model == "bv" && num_args == 2) {
+      return bounded_valence<graph_type>(arg(0), arg(1), rng);
+    } else if (model == "pattern" && (num_args == 3 || num_args == 4)) {
+      std::ifstream in{argv[k], std::ios::in|std::ios::binary};
+      auto h = word_bits == 32 ?
+          read_amalfi<graph_type, std::uint32_t>(in) :
+          read_amalfi<graph_type, std::uint16_t>(in);
+      bool induced = std::strcmp(argv[k+2], "mono") != 0;
+      double keep = num_args == 4 ? std::atof(argv[k+3]) : 0.5;
+      return random_pattern<graph_type>(h, arg(1), induced, rng, keep);
+    } else {
+      std::cerr << "bad model or arguments: " << model << std::endl;
+      std::exit(2);
+    }
+  }();
+
+  return word_bits == 32 ?
+      write<std::uint32_t>(filename, g) :
+      write<std::uint16_t>(filename, g);
+}
@@ -0,0 +1,71 @@
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+
+#include "include/read_amalfi.h"
+#include "include/simple_adjacency_list.h"
+#include "include/predefined.h"
+#include "include/predefined_generators.h"
+
+// Times ri_ind with a counting callback against ri_ind_gen driven by a
+// range-for loop over the same instance (C++20).
+//
+//   generator_bench pattern.gr target.gr [repetitions]
+//
+// Prints the best time of each and their ratio.
+
+int main(int argc, char * argv[]) {
+  std::ifstream g_in{argv[1], std::ios::in|std::ios::binary};
+  std::ifstream h_in{argv[2], std::ios::in|std::ios::binary};
+  unsigned repetitions = argc > 3 ? std::atoi(argv[3]) : 5;
+
+  auto g = read_amalfi<simple_adjacency_list<std::uint16_t>>(g_in);
+  auto h = read_amalfi<simple_adjacency_list<std::uint16_t>>(h_in);
+  prepared_target<decltype(h)> target{h};
+  target.build<adjacency_listmat<std::uint16_t>>();
+
+  auto vertex_comp = [](auto x, auto y) {return true;};
+  auto edge_comp = [](auto x0, auto x1, auto y0, auto y1) {return true;};
+
+  using clock = std::chrono::steady_clock;
+  auto best_callback = clock::duration::max();
+  auto best_generator = clock::duration::max();
+  std::uint64_t callback_count = 0;
+  std::uint64_t generator_count = 0;
+  std::uint64_t checksum = 0;
+
+  for (unsigned rep=0; rep<repetitions; ++rep) {
+    callback_count = 0;
+    auto start = clock::now();
+    ri_ind(
+        g,
+        target,
+        [&callback_count](auto const &) {
+          ++callback_count;
+          return true;
+        },
+        vertex_comp,
+        edge_comp);
+    best_callback = std::min(best_callback, clock::now() - start);
+
+    generator_count = 0;
+    start = clock::now();
+    for (auto const & e : ri_ind_gen(g, target, vertex_comp, edge_comp)) {
+      ++generator_count;
+      checksum += e[0];
+    }
+    best_generator = std::min(best_generator, clock::now() - start);
+  }
+
+  auto ms = [](clock::duration d) {
+    return std::chrono::duration<double, std::milli>(d).count();
+  };
+  std::cout << "solutions: " << callback_count << " / " << generator_count << " (checksum " << checksum << ")" << std::endl;
+  std::cout << "callback: " << ms(best_callback) << " ms" << std::endl;
+  std::cout << "generator: " << ms(best_generator) << " ms" << std::endl;
+  std::cout << "ratio: " << ms(best_generator) / ms(best_callback) << std::endl;
+  return callback_count == generator_count ? 0 : 1;
+}
@@ -1,6 +1,7 @@
 #ifndef ADJACENCY_LISTMAT_WITH_NOT_H_
 #define ADJACENCY_LISTMAT_WITH_NOT_H_
 
+#include <cstddef>
 #include <vector>
 
 #include "graph_traits.h"
@@ -27,11 +28,11 @@ class adjacency_listmat_with_not {
   std::vector<bool> mat;
   
   void set(index_type i, index_type j) {
-    mat[i*n + j] = true;
+    mat[static_cast<std::size_t>(i)*n + j] = true;
   }
   
   bool get(index_type i, index_type j) const {
-    return mat[i*n + j];
+    return mat[static_cast<std::size_t>(i)*n + j];
   }
   
  public:
@@ -39,7 +40,7 @@ class adjacency_listmat_with_not {
   explicit adjacency_listmat_with_not(G const & g)
       : n{g.num_vertices()},
         nodes(n),
-        mat(n * n) {
+        mat(static_cast<std::size_t>(n)*n) {
     for (index_type u=0; u<n; ++u) {
       for (auto v : g.adjacent_vertices(u)) {
         nodes[u].out.push_back(v);
@@ -1,6 +1,7 @@
 #ifndef ADJACENCY_MATRIX_H_
 #define ADJACENCY_MATRIX_H_
 
+#include <cstddef>
 #include <vector>
 
 #include "graph_traits.h"
@@ -19,21 +20,21 @@ class adjacency_matrix {
   std::vector<index_type> indeg;
   
   void set(index_type i, index_type j) {
-    mat[i*n + j] = true;
+    mat[static_cast<std::size_t>(i)*n + j] = true;
   }
   
   bool get(index_type i, index_type j) const {
-    return mat[i*n + j];
+    return mat[static_cast<std::size_t>(i)*n + j];
   }
   
  public:
   template <typename G>
   explicit adjacency_matrix(G const & g)
       : n{g.num_vertices()},
-        mat(n * n),
+        mat(static_cast<std::size_t>(n)*n),
         outdeg(n),
         indeg(n) {
-    for (int u=0; u<n; ++u) {
+    for (index_type u=0; u<n; ++u) {
       for (auto v : g.adjacent_vertices(u)) {
         set(u, v);
         ++outdeg[u];
@@ -0,0 +1,213 @@
+#ifndef ALLDIFFERENT_H_
+#define ALLDIFFERENT_H_
+
+#include <cstddef>
+#include <algorithm>
+#include <vector>
+
+// Injectivity filters for the states that keep a compatibility matrix M.
+// filter() looks at the bipartite graph between the unmapped pattern
+// vertices (map[i] == n) and the free target vertices (inv[j] == m) with
+// the pairs M still allows as edges, and calls unset(i, j) on every pair
+// that no injective assignment of all unmapped vertices can use. It
+// returns false if there is no such assignment at all.
+
+// Does nothing; the default of the states.
+struct no_alldifferent {
+  template <
+      typename IndexG,
+      typename IndexH>
+  no_alldifferent(IndexG, IndexH) {
+  }
+
+  template <
+      typename CompatibilityMatrix,
+      typename Map,
+      typename Inv,
+      typename Unset>
+  bool filter(CompatibilityMatrix const &, Map const &, Inv const &, Unset) {
+    return true;
+  }
+};
+
+// Regin's filter: a maximum matching covering the unmapped vertices, kept
+// from call to call as the starting point of the next one, then every
+// unmatched pair that lies neither on an alternating path from a free
+// target vertex nor on an alternating cycle is removed. This catches Hall
+// sets, groups of pattern vertices whose candidates are exactly as many
+// as they are, long before the search runs into them.
+template <
+    typename IndexG,
+    typename IndexH>
+class alldifferent_filter {
+ private:
+  IndexG m;
+  IndexH n;
+
+  std::vector<IndexH> row_match;
+  std::vector<IndexG> col_match;
+  std::vector<IndexG> rows;
+
+  std::vector<std::size_t> seen;
+  std::size_t stamp = 0;
+
+  std::vector<char> col_reached;
+  std::vector<char> row_reached;
+  std::vector<IndexG> col_queue;
+
+  // Tarjan on the rows that no free target vertex reaches, i -> i' if
+  // i' may take the target vertex matched to i
+  std::vector<IndexG> component;
+  std::vector<IndexG> low;
+  std::vector<IndexG> index;
+  std::vector<char> on_stack;
+  std::vector<IndexG> stack;
+  IndexG next_index;
+  IndexG next_component;
+
+  template <
+      typename CompatibilityMatrix,
+      typename Inv>
+  bool augment(CompatibilityMatrix const & M, Inv const & inv, IndexG i) {
+    for (IndexH j=0; j<n; ++j) {
+      if (seen[j] != stamp && inv[j] == m && M.get(i, j)) {
+        seen[j] = stamp;
+        if (col_match[j] == m || augment(M, inv, col_match[j])) {
+          row_match[i] = j;
+          col_match[j] = i;
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  template <typename CompatibilityMatrix>
+  void strong_connect(CompatibilityMatrix const & M, IndexG i) {
+    index[i] = low[i] = next_index++;
+    stack.push_back(i);
+    on_stack[i] = true;
+    auto j = row_match[i];
+    for (auto k : rows) {
+      if (k == i || row_reached[k] || !M.get(k, j)) {
+        continue;
+      }
+      if (index[k] == m) {
+        strong_connect(M, k);
+        low[i] = std::min(low[i], low[k]);
+      } else if (on_stack[k]) {
+        low[i] = std::min(low[i], index[k]);
+      }
+    }
+    if (low[i] == index[i]) {
+      IndexG k;
+      do {
+        k = stack.back();
+        stack.pop_back();
+        on_stack[k] = false;
+        component[k] = next_component;
+      } while (k != i);
+      ++next_component;
+    }
+  }
+
+ public:
+  alldifferent_filter(IndexG m, IndexH n)
+      : m{m},
+        n{n},
+        row_match(m, n),
+        col_match(n, m),
+        seen(n),
+        col_reached(n),
+        row_reached(m),
+        component(m),
+        low(m),
+        index(m),
+        on_stack(m) {
+  }
+
+  template <
+      typename CompatibilityMatrix,
+      typename Map,
+      typename Inv,
+      typename Unset>
+  bool filter(CompatibilityMatrix const & M, Map const & map, Inv const & inv, Unset unset) {
+    rows.clear();
+    std::fill(std::begin(col_match), std::end(col_match), m);
+    for (IndexG i=0; i<m; ++i) {
+      if (map[i] != n) {
+        row_match[i] = n;
+        continue;
+      }
+      rows.push_back(i);
+      auto j = row_match[i];
+      if (j != n && inv[j] == m && col_match[j] == m && M.get(i, j)) {
+        col_match[j] = i;
+      } else {
+        row_match[i] = n;
+      }
+    }
+    for (auto i : rows) {
+      if (row_match[i] == n) {
+        ++stamp;
+        if (!augment(M, inv, i)) {
+          return false;
+        }
+      }
+    }
+
+    // alternating paths: free target vertex -> row that may take it ->
+    // the target vertex matched to that row -> ...
+    std::fill(std::begin(col_reached), std::end(col_reached), false);
+    col_queue.clear();
+    for (IndexH j=0; j<n; ++j) {
+      if (inv[j] == m && col_match[j] == m) {
+        col_reached[j] = true;
+        col_queue.push_back(j);
+      }
+    }
+    for (auto i : rows) {
+      row_reached[i] = false;
+    }
+    for (std::size_t q=0; q<col_queue.size(); ++q) {
+      auto j = col_queue[q];
+      for (auto i : rows) {
+        if (!row_reached[i] && M.get(i, j)) {
+          row_reached[i] = true;
+          auto jj = row_match[i];
+          if (!col_reached[jj]) {
+            col_reached[jj] = true;
+            col_queue.push_back(jj);
+          }
+        }
+      }
+    }
+
+    for (auto i : rows) {
+      index[i] = m;
+      on_stack[i] = false;
+    }
+    next_index = 0;
+    next_component = 0;
+    for (auto i : rows) {
+      if (!row_reached[i] && index[i] == m) {
+        strong_connect(M, i);
+      }
+    }
+
+    for (auto i : rows) {
+      for (IndexH j=0; j<n; ++j) {
+        if (j == row_match[i] || col_reached[j] || inv[j] != m || !M.get(i, j)) {
+          continue;
+        }
+        auto k = col_match[j];
+        if (row_reached[i] || row_reached[k] || component[k] != component[i]) {
+          unset(i, j);
+        }
+      }
+    }
+    return true;
+  }
+};
+
+#endif  // ALLDIFFERENT_H_
@@ -0,0 +1,107 @@
+#ifndef BATCH_H_
+#define BATCH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "prepared_target.h"
+#include "scratch_arena.h"
+#include "search_limits.h"
+#include "search_statistics.h"
+
+// Bounds applied to every query of a batch separately.
+struct batch_limits {
+  std::chrono::steady_clock::duration timeout = std::chrono::steady_clock::duration::max();
+  std::uint64_t max_nodes = std::numeric_limits<std::uint64_t>::max();
+  std::uint64_t max_solutions = std::numeric_limits<std::uint64_t>::max();
+};
+
+struct batch_result {
+  // position of the pattern in the batch
+  std::size_t pattern;
+  std::uint64_t solutions;
+  search_statistics statistics;
+};
+
+// Matches every pattern against one prepared target on num_threads
+// threads, one query per thread at a time, and hands each batch_result to
+// on_result as soon as its query is done. on_result is called under a
+// lock, so it needs no synchronization of its own, but results arrive in
+// completion order. Patterns are started largest first so that a long
+// query does not end up last. Each thread keeps a scratch_arena across its
+// queries, so the domain, the compatibility matrix and the target-sized
+// arrays of the RI and ullimp states reuse one buffer per thread; since
+// the largest patterns come first, it is sized by them from the start.
+//
+// algorithm is called as algorithm(g, h, callback, vertex_comp, edge_comp,
+// limits), e.g. PORTFOLIO_ALGORITHM(ri_ind); the callback only counts.
+template <
+    typename G,
+    typename H,
+    typename Algorithm,
+    typename VertexEquivalencePredicate,
+    typename EdgeEquivalencePredicate,
+    typename OnResult>
+void batch_match(
+    std::vector<G> const & patterns,
+    prepared_target<H> const & h,
+    Algorithm algorithm,
+    VertexEquivalencePredicate vertex_comp,
+    EdgeEquivalencePredicate edge_comp,
+    OnResult on_result,
+    unsigned num_threads = std::thread::hardware_concurrency(),
+    batch_limits const & limits = {}) {
+  std::vector<std::size_t> order(patterns.size());
+  std::iota(std::begin(order), std::end(order), 0);
+  std::stable_sort(std::begin(order), std::end(order), [&patterns](std::size_t a, std::size_t b) {
+    return patterns[a].num_vertices() > patterns[b].num_vertices();
+  });
+
+  std::atomic<std::size_t> next{0};
+  std::mutex mutex;
+  auto work = [&]() {
+    scratch_arena arena;
+    for (auto k=next++; k<order.size(); k=next++) {
+      auto p = order[k];
+      search_limits query_limits;
+      if (limits.timeout != std::chrono::steady_clock::duration::max()) {
+        query_limits.within(limits.timeout);
+      }
+      query_limits.max_nodes = limits.max_nodes;
+      query_limits.max_solutions = limits.max_solutions;
+
+      std::uint64_t solutions = 0;
+      auto count = [&solutions](auto const &) {
+        ++solutions;
+        return true;
+      };
+      search_statistics statistics;
+      {
+        scratch_scope scope{arena};
+        statistics = algorithm(patterns[p], h, count, vertex_comp, edge_comp, &query_limits);
+      }
+
+      std::lock_guard<std::mutex> lock{mutex};
+      on_result(batch_result{p, solutions, statistics});
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (unsigned t=1; t<std::max(num_threads, 1u); ++t) {
+    threads.emplace_back(work);
+  }
+  work();
+  for (auto & thread : threads) {
+    thread.join();
+  }
+}
+
+#endif  // BATCH_H_
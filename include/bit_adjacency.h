@@ -0,0 +1,80 @@
+#ifndef BIT_ADJACENCY_H_
+#define BIT_ADJACENCY_H_
+
+#include <cstddef>
+
+#include "bit_row.h"
+
+// The adjacency of a graph as word-packed rows, one for the out- and one
+// for the in-neighbours of every vertex. If every arc has its reverse, the
+// in rows are the out rows and are not stored a second time. Only
+// adjacent_vertices() of the graph is used.
+template <typename Index>
+class bit_adjacency {
+ public:
+  using index_type = Index;
+
+ private:
+  index_type n;
+  std::size_t stride;
+
+  bit_row_vector out;
+  bit_row_vector in;
+  bool symmetric;
+
+  static void set(bit_row_vector & rows, std::size_t stride, std::size_t u, std::size_t v) {
+    rows[u*stride + v/bit_word_bits] |= static_cast<bit_word>(1) << (v % bit_word_bits);
+  }
+
+ public:
+  template <typename G>
+  explicit bit_adjacency(G const & g)
+      : n{g.num_vertices()},
+        stride{bit_row_words(n)},
+        out(static_cast<std::size_t>(n)*stride),
+        symmetric{true} {
+    for (index_type u=0; u<n; ++u) {
+      for (auto v : g.adjacent_vertices(u)) {
+        set(out, stride, u, v);
+      }
+    }
+    for (index_type u=0; u<n && symmetric; ++u) {
+      for (auto v : g.adjacent_vertices(u)) {
+        if (!bit_row_test(out_row(v), u)) {
+          symmetric = false;
+          break;
+        }
+      }
+    }
+    if (!symmetric) {
+      in.resize(out.size());
+      for (index_type u=0; u<n; ++u) {
+        for (auto v : g.adjacent_vertices(u)) {
+          set(in, stride, v, u);
+        }
+      }
+    }
+  }
+
+  index_type num_vertices() const {
+    return n;
+  }
+
+  std::size_t row_words() const {
+    return stride;
+  }
+
+  bool is_symmetric() const {
+    return symmetric;
+  }
+
+  bit_word const * out_row(index_type v) const {
+    return out.data() + static_cast<std::size_t>(v)*stride;
+  }
+
+  bit_word const * in_row(index_type v) const {
+    return (symmetric ? out : in).data() + static_cast<std::size_t>(v)*stride;
+  }
+};
+
+#endif  // BIT_ADJACENCY_H_
@@ -0,0 +1,217 @@
+#ifndef BIT_ROW_H_
+#define BIT_ROW_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+// Rows are arrays of 64-bit words whose length is a multiple of
+// bit_row_block, so every row starts on a cache line and the vector loops
+// below need no tail handling.
+
+using bit_word = std::uint64_t;
+
+constexpr std::size_t bit_word_bits = 64;
+constexpr std::size_t bit_row_block = 8;
+
+template <
+    typename T,
+    std::size_t Alignment>
+struct aligned_allocator {
+  using value_type = T;
+
+  template <typename U>
+  struct rebind {
+    using other = aligned_allocator<U, Alignment>;
+  };
+
+  aligned_allocator() = default;
+  template <typename U>
+  aligned_allocator(aligned_allocator<U, Alignment> const &) {
+  }
+
+  T * allocate(std::size_t k) {
+    return static_cast<T *>(::operator new(k * sizeof(T), std::align_val_t{Alignment}));
+  }
+  void deallocate(T * p, std::size_t) {
+    ::operator delete(p, std::align_val_t{Alignment});
+  }
+
+  template <typename U>
+  bool operator==(aligned_allocator<U, Alignment> const &) const {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(aligned_allocator<U, Alignment> const &) const {
+    return false;
+  }
+};
+
+using bit_row_vector = std::vector<bit_word, aligned_allocator<bit_word, 64>>;
+
+inline std::size_t bit_row_words(std::size_t bits) {
+  auto words = (bits + bit_word_bits - 1) / bit_word_bits;
+  return (words + bit_row_block - 1) / bit_row_block * bit_row_block;
+}
+
+inline bool bit_row_test(bit_word const * a, std::size_t j) {
+  return (a[j / bit_word_bits] >> (j % bit_word_bits)) & 1;
+}
+
+inline bool bit_row_any(bit_word const * a, std::size_t k) {
+#if defined(__AVX512F__)
+  for (std::size_t w=0; w<k; w+=8) {
+    if (_mm512_test_epi64_mask(_mm512_load_si512(a + w), _mm512_load_si512(a + w))) {
+      return true;
+    }
+  }
+  return false;
+#elif defined(__AVX2__)
+  for (std::size_t w=0; w<k; w+=4) {
+    auto va = _mm256_load_si256(reinterpret_cast<__m256i const *>(a + w));
+    if (!_mm256_testz_si256(va, va)) {
+      return true;
+    }
+  }
+  return false;
+#else
+  for (std::size_t w=0; w<k; ++w) {
+    if (a[w]) {
+      return true;
+    }
+  }
+  return false;
+#endif
+}
+
+// a & b != 0
+inline bool bit_row_intersects(bit_word const * a, bit_word const * b, std::size_t k) {
+#if defined(__AVX512F__)
+  for (std::size_t w=0; w<k; w+=8) {
+    if (_mm512_test_epi64_mask(_mm512_load_si512(a + w), _mm512_load_si512(b + w))) {
+      return true;
+    }
+  }
+  return false;
+#elif defined(__AVX2__)
+  for (std::size_t w=0; w<k; w+=4) {
+    auto va = _mm256_load_si256(reinterpret_cast<__m256i const *>(a + w));
+    auto vb = _mm256_load_si256(reinterpret_cast<__m256i const *>(b + w));
+    if (!_mm256_testz_si256(va, vb)) {
+      return true;
+    }
+  }
+  return false;
+#else
+  for (std::size_t w=0; w<k; ++w) {
+    if (a[w] & b[w]) {
+      return true;
+    }
+  }
+  return false;
+#endif
+}
+
+// a & ~b == 0
+inline bool bit_row_subset(bit_word const * a, bit_word const * b, std::size_t k) {
+#if defined(__AVX512F__)
+  for (std::size_t w=0; w<k; w+=8) {
+    auto va = _mm512_load_si512(a + w);
+    if (_mm512_test_epi64_mask(_mm512_andnot_si512(_mm512_load_si512(b + w), va), va)) {
+      return false;
+    }
+  }
+  return true;
+#elif defined(__AVX2__)
+  for (std::size_t w=0; w<k; w+=4) {
+    auto va = _mm256_load_si256(reinterpret_cast<__m256i const *>(a + w));
+    auto vb = _mm256_load_si256(reinterpret_cast<__m256i const *>(b + w));
+    if (!_mm256_testc_si256(vb, va)) {
+      return false;
+    }
+  }
+  return true;
+#else
+  for (std::size_t w=0; w<k; ++w) {
+    if (a[w] & ~b[w]) {
+      return false;
+    }
+  }
+  return true;
+#endif
+}
+
+inline std::size_t bit_row_count(bit_word const * a, std::size_t k) {
+#if defined(__AVX512VPOPCNTDQ__)
+  auto acc = _mm512_setzero_si512();
+  for (std::size_t w=0; w<k; w+=8) {
+    acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(_mm512_load_si512(a + w)));
+  }
+  return _mm512_reduce_add_epi64(acc);
+#else
+  std::size_t count = 0;
+  for (std::size_t w=0; w<k; ++w) {
+    count += __builtin_popcountll(a[w]);
+  }
+  return count;
+#endif
+}
+
+inline void bit_row_and(bit_word * a, bit_word const * b, std::size_t k) {
+#if defined(__AVX512F__)
+  for (std::size_t w=0; w<k; w+=8) {
+    _mm512_store_si512(a + w, _mm512_and_si512(_mm512_load_si512(a + w), _mm512_load_si512(b + w)));
+  }
+#elif defined(__AVX2__)
+  for (std::size_t w=0; w<k; w+=4) {
+    auto pa = reinterpret_cast<__m256i *>(a + w);
+    auto vb = _mm256_load_si256(reinterpret_cast<__m256i const *>(b + w));
+    _mm256_store_si256(pa, _mm256_and_si256(_mm256_load_si256(pa), vb));
+  }
+#else
+  for (std::size_t w=0; w<k; ++w) {
+    a[w] &= b[w];
+  }
+#endif
+}
+
+inline void bit_row_andnot(bit_word * a, bit_word const * b, std::size_t k) {
+#if defined(__AVX512F__)
+  for (std::size_t w=0; w<k; w+=8) {
+    _mm512_store_si512(a + w, _mm512_andnot_si512(_mm512_load_si512(b + w), _mm512_load_si512(a + w)));
+  }
+#elif defined(__AVX2__)
+  for (std::size_t w=0; w<k; w+=4) {
+    auto pa = reinterpret_cast<__m256i *>(a + w);
+    auto vb = _mm256_load_si256(reinterpret_cast<__m256i const *>(b + w));
+    _mm256_store_si256(pa, _mm256_andnot_si256(vb, _mm256_load_si256(pa)));
+  }
+#else
+  for (std::size_t w=0; w<k; ++w) {
+    a[w] &= ~b[w];
+  }
+#endif
+}
+
+// first set bit at or after j, or k*bit_word_bits if there is none
+inline std::size_t bit_row_next(bit_word const * a, std::size_t k, std::size_t j) {
+  auto w = j / bit_word_bits;
+  if (w >= k) {
+    return k * bit_word_bits;
+  }
+  auto word = a[w] & (~static_cast<bit_word>(0) << (j % bit_word_bits));
+  while (!word) {
+    if (++w == k) {
+      return k * bit_word_bits;
+    }
+    word = a[w];
+  }
+  return w * bit_word_bits + __builtin_ctzll(word);
+}
+
+#endif  // BIT_ROW_H_
@@ -0,0 +1,121 @@
+#ifndef BIT_ULLMANN_REFINER_H_
+#define BIT_ULLMANN_REFINER_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "bit_row.h"
+#include "bit_adjacency.h"
+
+// Ullmann refinement over a word-packed compatibility matrix. (u,v) stays
+// compatible while every out-neighbour i of u has a candidate among the
+// out-neighbours of v (and likewise for in-neighbours), which is a single
+// row intersection against the bitset adjacency of h, which is built by
+// the caller and shared by every fork. Only rows whose pattern neighbours
+// changed since the last pass are revisited.
+template <
+    typename G,
+    typename H>
+class bit_ullmann_refiner {
+ private:
+  using IndexG = typename G::index_type;
+  using IndexH = typename H::index_type;
+
+  G const & g;
+  bit_adjacency<IndexH> const & a;
+
+  std::size_t stride;
+
+  std::vector<IndexG> queue;
+  std::vector<char> queued;
+
+  void enqueue(IndexG u) {
+    if (!queued[u]) {
+      queued[u] = true;
+      queue.push_back(u);
+    }
+  }
+
+ public:
+  bit_ullmann_refiner(G const & g, bit_adjacency<IndexH> const & a)
+      : g{g},
+        a{a},
+        stride{a.row_words()},
+        queued(g.num_vertices()) {
+  }
+
+  bit_word const * out_row(IndexH v) const {
+    return a.out_row(v);
+  }
+  bit_word const * in_row(IndexH v) const {
+    return a.in_row(v);
+  }
+
+  // row i of the matrix changed, so its pattern neighbours need a recheck
+  void touch(IndexG i) {
+    for (auto u : g.adjacent_vertices(i)) {
+      enqueue(u);
+    }
+    for (auto u : g.inv_adjacent_vertices(i)) {
+      enqueue(u);
+    }
+  }
+
+  void clear() {
+    for (auto u : queue) {
+      queued[u] = false;
+    }
+    queue.clear();
+  }
+
+  void touch_all() {
+    for (IndexG u=0; u<g.num_vertices(); ++u) {
+      enqueue(u);
+    }
+  }
+
+  template <typename CompatibilityMatrix>
+  bool ullmann_condition(CompatibilityMatrix const & M, IndexG u, IndexH v) const {
+    for (auto i : g.adjacent_vertices(u)) {
+      if (!M.intersects(i, out_row(v))) {
+        return false;
+      }
+    }
+    for (auto i : g.inv_adjacent_vertices(u)) {
+      if (!M.intersects(i, in_row(v))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // false as soon as some row has no candidate left
+  template <typename CompatibilityMatrix>
+  bool refine(CompatibilityMatrix & M) {
+    auto end = stride*bit_word_bits;
+    while (!queue.empty()) {
+      auto u = queue.back();
+      queue.pop_back();
+      queued[u] = false;
+
+      auto row = M.row(u);
+      bool changed = false;
+      for (auto v=bit_row_next(row, stride, 0); v<end; v=bit_row_next(row, stride, v+1)) {
+        if (!ullmann_condition(M, u, v)) {
+          M.unset(u, v);
+          changed = true;
+        }
+      }
+      if (changed) {
+        if (!M.possible(u)) {
+          clear();
+          return false;
+        }
+        touch(u);
+      }
+    }
+    return true;
+  }
+};
+
+#endif  // BIT_ULLMANN_REFINER_H_
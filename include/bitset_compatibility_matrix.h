@@ -1,6 +1,9 @@
 #ifndef BITSET_COMPATIBILITY_MATRIX_H_
 #define BITSET_COMPATIBILITY_MATRIX_H_
 
+#include <cstddef>
+#include <iterator>
+#include <algorithm>
 #include <vector>
 #include <bitset>
 
@@ -14,7 +17,7 @@ class bitset_compatibility_matrix {
   IndexG const m;
   IndexH const n;
   
-  decltype((m*n+sizeof(bin_type))/sizeof(bin_type)) const frame_size;
+  decltype((static_cast<std::size_t>(m)*n+sizeof(bin_type))/sizeof(bin_type)) const frame_size;
 
   IndexG l;
   std::vector<bin_type> data;
@@ -22,21 +25,34 @@ class bitset_compatibility_matrix {
   bitset_compatibility_matrix(IndexG m, IndexH n)
       : m{m},
         n{n},
-        frame_size{(m*n+sizeof(bin_type))/sizeof(bin_type)},
+        frame_size{(static_cast<std::size_t>(m)*n+sizeof(bin_type))/sizeof(bin_type)},
         l{0},
         data((m+1)*frame_size) {
   }
+  
+  // a copy holds only the current frame and cannot revert past it
+  bitset_compatibility_matrix(bitset_compatibility_matrix const & other)
+      : m{other.m},
+        n{other.n},
+        frame_size{other.frame_size},
+        l{other.l},
+        data((m+1)*frame_size) {
+    std::copy_n(
+        std::next(std::begin(other.data), l*frame_size),
+        frame_size,
+        std::next(std::begin(data), l*frame_size));
+  }
 
   bool get(IndexG i, IndexH j) const {
-    auto idx = i*n + j;
+    auto idx = static_cast<std::size_t>(i)*n + j;
     return data[l*frame_size + (idx / sizeof(bin_type))].test(idx % 8);
   }
   void set(IndexG i, IndexH j) {
-    auto idx = i*n + j;
+    auto idx = static_cast<std::size_t>(i)*n + j;
     data[l*frame_size + (idx / sizeof(bin_type))].set(idx % 8);
   }
   void unset(IndexG i, IndexH j) {
-    auto idx = i*n + j;
+    auto idx = static_cast<std::size_t>(i)*n + j;
     data[l*frame_size + (idx / sizeof(bin_type))].reset(idx % 8);
   }
 
@@ -1,6 +1,7 @@
 #ifndef COMPATIBILITY_MATRIX_H_
 #define COMPATIBILITY_MATRIX_H_
 
+#include <cstddef>
 #include <iterator>
 #include <algorithm>
 #include <vector>
@@ -21,17 +22,29 @@ class compatibility_matrix {
       : m{m},
         n{n},
         l{0},
-        data((m+1)*m*n) {
+        data((static_cast<std::size_t>(m)+1)*m*n) {
+  }
+  
+  // a copy holds only the current frame and cannot revert past it
+  compatibility_matrix(compatibility_matrix const & other)
+      : m{other.m},
+        n{other.n},
+        l{other.l},
+        data((static_cast<std::size_t>(m)+1)*m*n) {
+    std::copy_n(
+        std::next(std::begin(other.data), static_cast<std::size_t>(l)*m*n),
+        static_cast<std::size_t>(m)*n,
+        std::next(std::begin(data), static_cast<std::size_t>(l)*m*n));
   }
 
   bool get(IndexG i, IndexH j) const {
-    return data[l*m*n + i*n + j];
+    return data[static_cast<std::size_t>(l)*m*n + static_cast<std::size_t>(i)*n + j];
   }
   void set(IndexG i, IndexH j) {
-    data[l*m*n + i*n + j] = true;
+    data[static_cast<std::size_t>(l)*m*n + static_cast<std::size_t>(i)*n + j] = true;
   }
   void unset(IndexG i, IndexH j) {
-    data[l*m*n + i*n + j] = false;
+    data[static_cast<std::size_t>(l)*m*n + static_cast<std::size_t>(i)*n + j] = false;
   }
   
   bool possible(IndexG i) const {
@@ -44,9 +57,9 @@ class compatibility_matrix {
   }
 
   void advance() {
-    auto s_it = std::next(std::begin(data),l*m*n);
-    auto t_it = std::next(s_it,m*n);
-    std::copy_n(s_it,m*n,t_it);
+    auto s_it = std::next(std::begin(data),static_cast<std::size_t>(l)*m*n);
+    auto t_it = std::next(s_it,static_cast<std::size_t>(m)*n);
+    std::copy_n(s_it,static_cast<std::size_t>(m)*n,t_it);
     ++l;
   }
   void revert() {
@@ -0,0 +1,595 @@
+#ifndef COMPRESSED_COUNT_H_
+#define COMPRESSED_COUNT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+#include "adjacency_listmat.h"
+#include "simple_adjacency_list.h"
+#include "prepared_target.h"
+#include "vertex_order.h"
+#include "predefined.h"
+#include "search_limits.h"
+
+// Counts the ways of giving every item its own target vertex, where items
+// come in groups and each item of a group may take any vertex of the
+// group's (sorted) vertex list. Groups sharing no vertex with another are
+// counted in closed form; the others by a dynamic program over how many
+// items of each group are placed, taking the shared vertices class by
+// class, a class being the vertices contained in the same groups.
+template <
+    typename Count,
+    typename IndexH>
+class injective_counter {
+ public:
+  struct group {
+    std::vector<IndexH> const * vertices;
+    std::size_t k;
+  };
+
+ private:
+  static constexpr std::size_t max_shared = 64;
+  static constexpr std::size_t max_states = std::size_t{1} << 20;
+
+  // per target vertex, the number of groups containing it, and the bit
+  // set of shared groups containing it
+  std::vector<std::uint32_t> hits;
+  std::vector<std::uint64_t> membership;
+
+  std::vector<std::size_t> shared;
+  std::vector<IndexH> touched;
+  std::vector<std::uint64_t> masks;
+  std::vector<Count> dp;
+  std::vector<Count> next_dp;
+  std::vector<char> used;
+
+  static Count falling(std::size_t c, std::size_t k) {
+    Count result = 1;
+    for (std::size_t i=0; i<k; ++i) {
+      result *= static_cast<Count>(c - i);
+    }
+    return result;
+  }
+
+  // multiplicatively, C(r, k+1) = C(r, k) * (r-k) / (k+1), which divides
+  // exactly at every step and stays far from overflow where r!/(r-a)! and
+  // a! would not
+  static Count binomial(std::size_t r, std::size_t a) {
+    a = std::min(a, r - a);
+    Count result = 1;
+    for (std::size_t k=0; k<a; ++k) {
+      result = result * static_cast<Count>(r - k) / static_cast<Count>(k + 1);
+    }
+    return result;
+  }
+
+  // places a_i further items of every group i in mask into a class of c
+  // vertices, for every choice of the a_i
+  void spread(
+      std::vector<group> const & groups,
+      std::vector<std::size_t> const & radix,
+      std::vector<std::size_t> const & placed,
+      std::uint64_t mask,
+      std::size_t c,
+      std::size_t i,
+      std::size_t state,
+      std::size_t total,
+      Count ways) {
+    if (i == shared.size()) {
+      next_dp[state] += ways * falling(c, total);
+      return;
+    }
+    spread(groups, radix, placed, mask, c, i+1, state, total, ways);
+    if (mask & (std::uint64_t{1} << i)) {
+      auto left = groups[shared[i]].k - placed[i];
+      for (std::size_t a=1; a<=left && total+a<=c; ++a) {
+        spread(groups, radix, placed, mask, c, i+1, state + a*radix[i], total+a, ways * binomial(left, a));
+      }
+    }
+  }
+
+  Count enumerate(std::vector<group> const & groups, std::size_t g, std::size_t k) {
+    if (g == shared.size()) {
+      return 1;
+    }
+    if (k == groups[shared[g]].k) {
+      return enumerate(groups, g+1, 0);
+    }
+    Count total = 0;
+    for (auto y : *groups[shared[g]].vertices) {
+      if (!used[y]) {
+        used[y] = true;
+        total += enumerate(groups, g, k+1);
+        used[y] = false;
+      }
+    }
+    return total;
+  }
+
+  Count count_shared(std::vector<group> const & groups) {
+    if (shared.size() > max_shared) {
+      return enumerate(groups, 0, 0);
+    }
+    std::vector<std::size_t> radix(shared.size());
+    std::size_t states = 1;
+    for (std::size_t i=0; i<shared.size(); ++i) {
+      radix[i] = states;
+      states *= groups[shared[i]].k + 1;
+      if (states > max_states) {
+        return enumerate(groups, 0, 0);
+      }
+    }
+
+    touched.clear();
+    for (std::size_t i=0; i<shared.size(); ++i) {
+      for (auto y : *groups[shared[i]].vertices) {
+        if (membership[y] == 0) {
+          touched.push_back(y);
+        }
+        membership[y] |= std::uint64_t{1} << i;
+      }
+    }
+    masks.clear();
+    for (auto y : touched) {
+      masks.push_back(membership[y]);
+      membership[y] = 0;
+    }
+    std::sort(std::begin(masks), std::end(masks));
+
+    dp.assign(states, 0);
+    dp[0] = 1;
+    std::vector<std::size_t> placed(shared.size());
+    for (std::size_t b=0, e; b<masks.size(); b=e) {
+      for (e=b; e<masks.size() && masks[e]==masks[b]; ++e) {
+      }
+      next_dp.assign(states, 0);
+      for (std::size_t state=0; state<states; ++state) {
+        if (dp[state] == 0) {
+          continue;
+        }
+        for (std::size_t i=0; i<shared.size(); ++i) {
+          placed[i] = state / radix[i] % (groups[shared[i]].k + 1);
+        }
+        spread(groups, radix, placed, masks[b], e-b, 0, state, 0, dp[state]);
+      }
+      std::swap(dp, next_dp);
+    }
+    return dp[states-1];
+  }
+
+ public:
+  explicit injective_counter(IndexH n)
+      : hits(n),
+        membership(n),
+        used(n) {
+  }
+
+  Count count(std::vector<group> const & groups) {
+    for (auto const & gr : groups) {
+      if (gr.vertices->size() < gr.k) {
+        return 0;
+      }
+      for (auto y : *gr.vertices) {
+        ++hits[y];
+      }
+    }
+    Count result = 1;
+    shared.clear();
+    for (std::size_t i=0; i<groups.size(); ++i) {
+      auto const & vertices = *groups[i].vertices;
+      if (std::all_of(std::begin(vertices), std::end(vertices), [this](auto y) {return hits[y] == 1;})) {
+        result *= falling(vertices.size(), groups[i].k);
+      } else {
+        shared.push_back(i);
+      }
+    }
+    for (auto const & gr : groups) {
+      for (auto y : *gr.vertices) {
+        hits[y] = 0;
+      }
+    }
+    if (!shared.empty() && result != 0) {
+      result *= count_shared(groups);
+    }
+    return result;
+  }
+};
+
+// A pattern split into a core, searched for as usual, and a tail of
+// pairwise non-adjacent vertices whose neighbours all lie in the core, so
+// that once the core is mapped every tail vertex has a candidate set of
+// its own. The tail is the longest independent suffix of the greatest-
+// constraint-first order, then every degree-one vertex hanging off the
+// core; the core keeps at least one vertex.
+template <typename IndexG>
+struct compressed_pattern {
+  struct tail_arc {
+    // index of the neighbour in core
+    IndexG neighbour;
+    // tail vertex -> neighbour, neighbour -> tail vertex
+    bool out;
+    bool in;
+  };
+
+  std::vector<IndexG> core;
+  std::vector<IndexG> tail;
+  std::vector<std::vector<tail_arc>> arcs;
+  simple_adjacency_list<IndexG> core_graph{0};
+
+  template <typename G>
+  explicit compressed_pattern(G const & g) {
+    IndexG m = g.num_vertices();
+    std::vector<char> in_tail(m);
+    IndexG tail_size = 0;
+
+    auto try_tail = [&](IndexG v) {
+      if (tail_size+1 >= m || in_tail[v] || g.edge(v, v)) {
+        return false;
+      }
+      for (auto u : g.adjacent_vertices(v)) {
+        if (in_tail[u]) {
+          return false;
+        }
+      }
+      for (auto u : g.inv_adjacent_vertices(v)) {
+        if (in_tail[u]) {
+          return false;
+        }
+      }
+      in_tail[v] = true;
+      ++tail_size;
+      return true;
+    };
+
+    auto order = vertex_order_GreatestConstraintFirst(g);
+    for (auto it=order.rbegin(); it!=order.rend() && try_tail(*it); ++it) {
+    }
+    for (IndexG v=0; v<m; ++v) {
+      std::vector<IndexG> neighbours(std::begin(g.adjacent_vertices(v)), std::end(g.adjacent_vertices(v)));
+      for (auto u : g.inv_adjacent_vertices(v)) {
+        neighbours.push_back(u);
+      }
+      std::sort(std::begin(neighbours), std::end(neighbours));
+      if (std::unique(std::begin(neighbours), std::end(neighbours)) - std::begin(neighbours) == 1) {
+        try_tail(v);
+      }
+    }
+
+    std::vector<IndexG> local(m);
+    for (IndexG v=0; v<m; ++v) {
+      if (in_tail[v]) {
+        local[v] = tail.size();
+        tail.push_back(v);
+      } else {
+        local[v] = core.size();
+        core.push_back(v);
+      }
+    }
+
+    core_graph = simple_adjacency_list<IndexG>(core.size());
+    arcs.resize(tail.size());
+    for (IndexG v=0; v<m; ++v) {
+      for (auto u : g.adjacent_vertices(v)) {
+        if (!in_tail[v] && !in_tail[u]) {
+          core_graph.add_edge(local[v], local[u]);
+        } else if (in_tail[v]) {
+          arcs[local[v]].push_back({local[u], true, g.edge(u, v)});
+        } else if (!g.edge(u, v)) {
+          arcs[local[u]].push_back({local[v], false, true});
+        }
+      }
+    }
+  }
+};
+
+// Solution callback of the core search: completes every core embedding by
+// counting the injective assignments of the tail instead of enumerating
+// them. Like solution_counter, every copy counts locally and adds its
+// count to the shared total when it is destroyed.
+//
+// If Induced, a candidate must also be non-adjacent to the images of the
+// core vertices its tail vertex is not adjacent to, and the images of the
+// tail must be pairwise non-adjacent. When no two candidates are adjacent
+// in h the latter holds anyway and the tail is counted as for Mono;
+// otherwise its assignments are enumerated.
+template <
+    typename Count,
+    typename G,
+    typename H,
+    typename VertexEquivalencePredicate,
+    typename EdgeEquivalencePredicate,
+    bool Induced = false>
+class tail_counter {
+ private:
+  using IndexG = typename G::index_type;
+  using IndexH = typename H::index_type;
+  using group = typename injective_counter<Count, IndexH>::group;
+
+  compressed_pattern<IndexG> const & P;
+  G const & g;
+  H const & h;
+  VertexEquivalencePredicate vertex_comp;
+  EdgeEquivalencePredicate edge_comp;
+
+  Count * total;
+  std::mutex * mutex;
+  Count count;
+
+  injective_counter<Count, IndexH> counter;
+  std::vector<std::vector<IndexH>> candidates;
+  std::vector<IndexG> by_candidates;
+  std::vector<group> groups;
+
+  // per target vertex, whether it is a candidate (Induced) or already
+  // taken by the tail (enumerate_tail)
+  std::vector<char> marks;
+  std::vector<IndexH> chosen;
+
+  template <typename Embedding>
+  void fill_candidates(Embedding const & e, IndexG t) {
+    auto x = P.tail[t];
+    auto & c = candidates[t];
+    c.clear();
+    auto const & arcs = P.arcs[t];
+
+    auto consistent = [&](IndexH y) {
+      if (e.inverse(y) != e.size() || !vertex_comp(x, y)) {
+        return false;
+      }
+      if constexpr (Induced) {
+        if (h.edge(y, y)) {
+          return false;
+        }
+        for (IndexG c=0; c<P.core.size(); ++c) {
+          auto u = P.core[c];
+          auto v = e[c];
+          if (g.edge(x, u) != h.edge(y, v) || g.edge(u, x) != h.edge(v, y)) {
+            return false;
+          }
+        }
+      }
+      for (auto const & a : arcs) {
+        auto u = P.core[a.neighbour];
+        auto v = e[a.neighbour];
+        if (a.out && (!h.edge(y, v) || !edge_comp(x, u, y, v))) {
+          return false;
+        }
+        if (a.in && (!h.edge(v, y) || !edge_comp(u, x, v, y))) {
+          return false;
+        }
+      }
+      return true;
+    };
+
+    if (arcs.empty()) {
+      for (IndexH y=0; y<h.num_vertices(); ++y) {
+        if (consistent(y)) {
+          c.push_back(y);
+        }
+      }
+      return;
+    }
+    // scan the shortest adjacency list the arcs allow
+    std::vector<IndexH> const * scan = nullptr;
+    for (auto const & a : arcs) {
+      auto const & list = a.out ? h.inv_adjacent_vertices(e[a.neighbour]) : h.adjacent_vertices(e[a.neighbour]);
+      if (scan == nullptr || list.size() < scan->size()) {
+        scan = &list;
+      }
+    }
+    for (auto y : *scan) {
+      if (consistent(y)) {
+        c.push_back(y);
+      }
+    }
+    std::sort(std::begin(c), std::end(c));
+  }
+
+  // whether some two candidates, of one tail vertex or of two, are
+  // adjacent in h
+  bool candidates_adjacent() {
+    for (auto const & c : candidates) {
+      for (auto y : c) {
+        marks[y] = true;
+      }
+    }
+    bool adjacent = false;
+    for (auto const & c : candidates) {
+      for (auto y : c) {
+        for (auto z : h.adjacent_vertices(y)) {
+          adjacent = adjacent || marks[z];
+        }
+      }
+    }
+    for (auto const & c : candidates) {
+      for (auto y : c) {
+        marks[y] = false;
+      }
+    }
+    return adjacent;
+  }
+
+  // the assignments of the tail vertices by_candidates[t..] to distinct,
+  // pairwise non-adjacent candidates
+  Count enumerate_tail(std::size_t t) {
+    if (t == by_candidates.size()) {
+      return 1;
+    }
+    Count total = 0;
+    for (auto y : candidates[by_candidates[t]]) {
+      if (marks[y]) {
+        continue;
+      }
+      bool independent = true;
+      for (std::size_t s=0; s<t && independent; ++s) {
+        independent = !h.edge(y, chosen[s]) && !h.edge(chosen[s], y);
+      }
+      if (independent) {
+        marks[y] = true;
+        chosen[t] = y;
+        total += enumerate_tail(t+1);
+        marks[y] = false;
+      }
+    }
+    return total;
+  }
+
+ public:
+  tail_counter(
+      compressed_pattern<IndexG> const & P,
+      G const & g,
+      H const & h,
+      VertexEquivalencePredicate const & vertex_comp,
+      EdgeEquivalencePredicate const & edge_comp,
+      Count & total,
+      std::mutex & mutex)
+      : P{P},
+        g{g},
+        h{h},
+        vertex_comp{vertex_comp},
+        edge_comp{edge_comp},
+        total{&total},
+        mutex{&mutex},
+        count{0},
+        counter{h.num_vertices()},
+        candidates(P.tail.size()),
+        by_candidates(P.tail.size()),
+        marks(Induced ? h.num_vertices() : 0),
+        chosen(Induced ? P.tail.size() : 0) {
+  }
+
+  tail_counter(tail_counter const & other)
+      : tail_counter(other.P, other.g, other.h, other.vertex_comp, other.edge_comp, *other.total, *other.mutex) {
+  }
+
+  tail_counter & operator=(tail_counter const &) = delete;
+
+  ~tail_counter() {
+    std::lock_guard<std::mutex> lock{*mutex};
+    *total += count;
+  }
+
+  template <typename Embedding>
+  bool operator()(Embedding const & e) {
+    for (IndexG t=0; t<P.tail.size(); ++t) {
+      fill_candidates(e, t);
+      by_candidates[t] = t;
+    }
+    if constexpr (Induced) {
+      if (candidates_adjacent()) {
+        // most constrained first
+        std::sort(std::begin(by_candidates), std::end(by_candidates), [this](auto a, auto b) {
+          return candidates[a].size() < candidates[b].size();
+        });
+        count += enumerate_tail(0);
+        return true;
+      }
+    }
+    // tail vertices with equal candidate sets form one group
+    std::sort(std::begin(by_candidates), std::end(by_candidates), [this](auto a, auto b) {
+      return candidates[a] < candidates[b];
+    });
+    groups.clear();
+    for (auto t : by_candidates) {
+      if (!groups.empty() && *groups.back().vertices == candidates[t]) {
+        ++groups.back().k;
+      } else {
+        groups.push_back({&candidates[t], 1});
+      }
+    }
+    count += counter.count(groups);
+    return true;
+  }
+};
+
+// Number of monomorphisms of g into h, as ullimp_bit_mono would enumerate
+// them, but with the tail of the pattern counted combinatorially for every
+// embedding of its core rather than searched. Count may be a wider
+// integer type, e.g. unsigned __int128 where available. With limits the
+// result only covers the part of the search done before they were hit.
+template <
+    typename Count = std::uint64_t,
+    typename G_,
+    typename H_,
+    typename VertexEquivalencePredicate,
+    typename EdgeEquivalencePredicate>
+Count compressed_count_mono(
+    G_ const & g_,
+    H_ const & h_,
+    VertexEquivalencePredicate vertex_comp,
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
+  using IndexG = typename G_::index_type;
+  adjacency_listmat<IndexG> g{g_};
+  if (g.num_vertices() == 0) {
+    return 1;
+  }
+  using H = adjacency_listmat<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+
+  compressed_pattern<IndexG> P{g};
+  auto core_vertex_comp = [&P, vertex_comp](auto i, auto j) {
+    return vertex_comp(P.core[i], j);
+  };
+  auto core_edge_comp = [&P, edge_comp](auto i0, auto i1, auto j0, auto j1) {
+    return edge_comp(P.core[i0], P.core[i1], j0, j1);
+  };
+
+  Count total = 0;
+  std::mutex mutex;
+  {
+    tail_counter<Count, decltype(g), H, VertexEquivalencePredicate, EdgeEquivalencePredicate> counter{
+        P, g, h, vertex_comp, edge_comp, total, mutex};
+    ullimp_bit_mono(P.core_graph, h_, counter, core_vertex_comp, core_edge_comp, num_threads, limits);
+  }
+  return total;
+}
+
+// Number of induced embeddings of g into h, as ullimp_ind would enumerate
+// them, with the tail counted as for compressed_count_mono whenever the
+// candidates of the tail are pairwise non-adjacent in h, and enumerated
+// on top of the core embedding otherwise.
+template <
+    typename Count = std::uint64_t,
+    typename G_,
+    typename H_,
+    typename VertexEquivalencePredicate,
+    typename EdgeEquivalencePredicate>
+Count compressed_count_ind(
+    G_ const & g_,
+    H_ const & h_,
+    VertexEquivalencePredicate vertex_comp,
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
+  using IndexG = typename G_::index_type;
+  adjacency_listmat<IndexG> g{g_};
+  if (g.num_vertices() == 0) {
+    return 1;
+  }
+  using H = adjacency_listmat<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+
+  compressed_pattern<IndexG> P{g};
+  auto core_vertex_comp = [&P, vertex_comp](auto i, auto j) {
+    return vertex_comp(P.core[i], j);
+  };
+  auto core_edge_comp = [&P, edge_comp](auto i0, auto i1, auto j0, auto j1) {
+    return edge_comp(P.core[i0], P.core[i1], j0, j1);
+  };
+
+  Count total = 0;
+  std::mutex mutex;
+  {
+    tail_counter<Count, decltype(g), H, VertexEquivalencePredicate, EdgeEquivalencePredicate, true> counter{
+        P, g, h, vertex_comp, edge_comp, total, mutex};
+    ullimp_ind(P.core_graph, h_, counter, core_vertex_comp, core_edge_comp, num_threads, limits);
+  }
+  return total;
+}
+
+#endif  // COMPRESSED_COUNT_H_
@@ -0,0 +1,119 @@
+#ifndef CSR_ADJACENCY_LIST_H_
+#define CSR_ADJACENCY_LIST_H_
+
+#include <cstddef>
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <boost/range/iterator_range.hpp>
+
+#include "graph_traits.h"
+
+// Compressed sparse rows in both directions: the out (in) neighbours of u
+// are out_adj[out_off[u]..out_off[u+1]), kept sorted so that edge() is a
+// binary search over the shorter of the two rows.
+template <typename Index>
+class csr_adjacency_list {
+ public:
+  using directed_category = bidirectional_tag;
+
+  using index_type = Index;
+  using adjacent_vertices_container_type = boost::iterator_range<index_type const *>;
+
+ private:
+  index_type n;
+
+  std::vector<std::size_t> out_off;
+  std::vector<index_type> out_adj;
+
+  std::vector<std::size_t> in_off;
+  std::vector<index_type> in_adj;
+
+  // fills the in direction from out_off/out_adj and sorts every row
+  void build_in() {
+    for (index_type u=0; u<n; ++u) {
+      std::sort(out_adj.data() + out_off[u], out_adj.data() + out_off[u+1]);
+    }
+    for (auto v : out_adj) {
+      ++in_off[v+1];
+    }
+    for (index_type u=0; u<n; ++u) {
+      in_off[u+1] += in_off[u];
+    }
+    in_adj.resize(in_off[n]);
+    std::vector<std::size_t> in_pos(std::begin(in_off), std::end(in_off)-1);
+    for (index_type u=0; u<n; ++u) {
+      for (auto i=out_off[u]; i<out_off[u+1]; ++i) {
+        in_adj[in_pos[out_adj[i]]++] = u;
+      }
+    }
+  }
+
+ public:
+  template <typename G>
+  explicit csr_adjacency_list(G const & g)
+      : n{g.num_vertices()},
+        out_off(n+1),
+        in_off(n+1) {
+    for (index_type u=0; u<n; ++u) {
+      auto const & adj = g.adjacent_vertices(u);
+      out_off[u+1] = out_off[u] + std::distance(std::begin(adj), std::end(adj));
+    }
+    out_adj.reserve(out_off[n]);
+    for (index_type u=0; u<n; ++u) {
+      for (auto v : g.adjacent_vertices(u)) {
+        out_adj.push_back(v);
+      }
+    }
+    build_in();
+  }
+
+  // takes ownership of already built out rows: the out neighbours of u
+  // are out_adj[out_off[u]..out_off[u+1])
+  csr_adjacency_list(
+      index_type n,
+      std::vector<std::size_t> out_off,
+      std::vector<index_type> out_adj)
+      : n{n},
+        out_off(std::move(out_off)),
+        out_adj(std::move(out_adj)),
+        in_off(n+1) {
+    build_in();
+  }
+
+  index_type num_vertices() const {
+    return n;
+  }
+
+  bool edge(index_type u, index_type v) const {
+    if (out_degree(u) <= in_degree(v)) {
+      return std::binary_search(out_adj.data() + out_off[u], out_adj.data() + out_off[u+1], v);
+    } else {
+      return std::binary_search(in_adj.data() + in_off[v], in_adj.data() + in_off[v+1], u);
+    }
+  }
+
+  index_type out_degree(index_type u) const {
+    return out_off[u+1] - out_off[u];
+  }
+
+  index_type in_degree(index_type u) const {
+    return in_off[u+1] - in_off[u];
+  }
+
+  index_type degree(index_type u) const {
+    return out_degree(u) + in_degree(u);
+  }
+
+  adjacent_vertices_container_type adjacent_vertices(index_type u) const {
+    return {out_adj.data() + out_off[u], out_adj.data() + out_off[u+1]};
+  }
+
+  adjacent_vertices_container_type inv_adjacent_vertices(index_type u) const {
+    return {in_adj.data() + in_off[u], in_adj.data() + in_off[u+1]};
+  }
+};
+
+#endif  // CSR_ADJACENCY_LIST_H_
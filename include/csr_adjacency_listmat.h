@@ -0,0 +1,70 @@
+#ifndef CSR_ADJACENCY_LISTMAT_H_
+#define CSR_ADJACENCY_LISTMAT_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "graph_traits.h"
+#include "csr_adjacency_list.h"
+
+// adjacency_listmat laid out as compressed sparse rows: the neighbour
+// lists are the contiguous rows of a csr_adjacency_list, and an n*n bitmap
+// keeps edge() constant time.
+template <typename Index>
+class csr_adjacency_listmat {
+ public:
+  using directed_category = bidirectional_tag;
+
+  using index_type = Index;
+  using adjacent_vertices_container_type = typename csr_adjacency_list<Index>::adjacent_vertices_container_type;
+
+ private:
+  index_type n;
+
+  csr_adjacency_list<index_type> lists;
+
+  std::vector<bool> mat;
+
+ public:
+  template <typename G>
+  explicit csr_adjacency_listmat(G const & g)
+      : n{g.num_vertices()},
+        lists{g},
+        mat(static_cast<std::size_t>(n)*n) {
+    for (index_type u=0; u<n; ++u) {
+      for (auto v : lists.adjacent_vertices(u)) {
+        mat[static_cast<std::size_t>(u)*n + v] = true;
+      }
+    }
+  }
+
+  index_type num_vertices() const {
+    return n;
+  }
+
+  bool edge(index_type u, index_type v) const {
+    return mat[static_cast<std::size_t>(u)*n + v];
+  }
+
+  index_type out_degree(index_type u) const {
+    return lists.out_degree(u);
+  }
+
+  index_type in_degree(index_type u) const {
+    return lists.in_degree(u);
+  }
+
+  index_type degree(index_type u) const {
+    return out_degree(u) + in_degree(u);
+  }
+
+  adjacent_vertices_container_type adjacent_vertices(index_type u) const {
+    return lists.adjacent_vertices(u);
+  }
+
+  adjacent_vertices_container_type inv_adjacent_vertices(index_type u) const {
+    return lists.inv_adjacent_vertices(u);
+  }
+};
+
+#endif  // CSR_ADJACENCY_LISTMAT_H_
@@ -0,0 +1,106 @@
+#ifndef CSR_ADJACENCY_LISTMAT_WITH_NOT_H_
+#define CSR_ADJACENCY_LISTMAT_WITH_NOT_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "graph_traits.h"
+#include "csr_adjacency_list.h"
+
+// adjacency_listmat_with_not laid out as compressed sparse rows: the
+// neighbour lists are the rows of a csr_adjacency_list, and the lists of
+// non-neighbours (other than u itself) are rows of two more flat arrays.
+template <typename Index>
+class csr_adjacency_listmat_with_not {
+ public:
+  using directed_category = bidirectional_tag;
+
+  using index_type = Index;
+  using adjacent_vertices_container_type = typename csr_adjacency_list<Index>::adjacent_vertices_container_type;
+
+ private:
+  index_type n;
+
+  csr_adjacency_list<index_type> lists;
+
+  std::vector<bool> mat;
+
+  // row u of either not-list holds n-1-(out or in degree of u without loops)
+  std::vector<std::size_t> not_out_off;
+  std::vector<index_type> not_out_adj;
+  std::vector<std::size_t> not_in_off;
+  std::vector<index_type> not_in_adj;
+
+  bool get(index_type i, index_type j) const {
+    return mat[static_cast<std::size_t>(i)*n + j];
+  }
+
+ public:
+  template <typename G>
+  explicit csr_adjacency_listmat_with_not(G const & g)
+      : n{g.num_vertices()},
+        lists{g},
+        mat(static_cast<std::size_t>(n)*n),
+        not_out_off(n+1),
+        not_in_off(n+1) {
+    for (index_type u=0; u<n; ++u) {
+      for (auto v : lists.adjacent_vertices(u)) {
+        mat[static_cast<std::size_t>(u)*n + v] = true;
+      }
+    }
+    for (index_type u=0; u<n; ++u) {
+      for (index_type v=0; v<n; ++v) {
+        if (v != u && !get(u, v)) {
+          not_out_adj.push_back(v);
+        }
+      }
+      not_out_off[u+1] = not_out_adj.size();
+    }
+    for (index_type u=0; u<n; ++u) {
+      for (index_type v=0; v<n; ++v) {
+        if (v != u && !get(v, u)) {
+          not_in_adj.push_back(v);
+        }
+      }
+      not_in_off[u+1] = not_in_adj.size();
+    }
+  }
+
+  index_type num_vertices() const {
+    return n;
+  }
+
+  bool edge(index_type u, index_type v) const {
+    return get(u, v);
+  }
+
+  index_type out_degree(index_type u) const {
+    return lists.out_degree(u);
+  }
+
+  index_type in_degree(index_type u) const {
+    return lists.in_degree(u);
+  }
+
+  index_type degree(index_type u) const {
+    return out_degree(u) + in_degree(u);
+  }
+
+  adjacent_vertices_container_type adjacent_vertices(index_type u) const {
+    return lists.adjacent_vertices(u);
+  }
+
+  adjacent_vertices_container_type inv_adjacent_vertices(index_type u) const {
+    return lists.inv_adjacent_vertices(u);
+  }
+
+  adjacent_vertices_container_type not_adjacent_vertices(index_type u) const {
+    return {not_out_adj.data() + not_out_off[u], not_out_adj.data() + not_out_off[u+1]};
+  }
+
+  adjacent_vertices_container_type not_inv_adjacent_vertices(index_type u) const {
+    return {not_in_adj.data() + not_in_off[u], not_in_adj.data() + not_in_off[u+1]};
+  }
+};
+
+#endif  // CSR_ADJACENCY_LISTMAT_WITH_NOT_H_
@@ -0,0 +1,56 @@
+#ifndef DEGREE_BUCKETS_H_
+#define DEGREE_BUCKETS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include <boost/range/iterator_range.hpp>
+
+// The vertices of a graph sorted by decreasing degree (out plus in), so
+// that the vertices of degree at least d are a prefix. An embedding maps
+// a vertex only to one of at least its degree. Only adjacent_vertices() of
+// the graph is used.
+template <typename Index>
+class degree_buckets {
+ public:
+  using index_type = Index;
+  using degree_type = std::uint32_t;
+
+ private:
+  std::vector<degree_type> degrees;
+  std::vector<index_type> order;
+
+ public:
+  template <typename G>
+  explicit degree_buckets(G const & g)
+      : degrees(g.num_vertices()),
+        order(g.num_vertices()) {
+    for (index_type u=0; u<g.num_vertices(); ++u) {
+      for (auto v : g.adjacent_vertices(u)) {
+        ++degrees[u];
+        ++degrees[v];
+      }
+    }
+    std::iota(std::begin(order), std::end(order), 0);
+    std::stable_sort(std::begin(order), std::end(order), [this](index_type u, index_type v) {
+      return degrees[u] > degrees[v];
+    });
+  }
+
+  degree_type degree(index_type u) const {
+    return degrees[u];
+  }
+
+  // the vertices of degree at least d
+  boost::iterator_range<index_type const *> at_least(degree_type d) const {
+    auto last = std::partition_point(std::begin(order), std::end(order), [this, d](index_type u) {
+      return degrees[u] >= d;
+    });
+    return {order.data(), order.data() + (last - std::begin(order))};
+  }
+};
+
+#endif  // DEGREE_BUCKETS_H_
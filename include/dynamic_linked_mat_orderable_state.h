@@ -2,11 +2,15 @@
 #define DYNAMIC_LINKED_MAT_ORDERABLE_STATE_H_
 
 #include <iterator>
+#include <memory>
 #include <vector>
 #include <stack>
 
 #include <boost/range/iterator_range.hpp>
 
+#include "embedding_view.h"
+#include "initial_candidates.h"
+
 template <
     typename G,
     typename H,
@@ -21,6 +25,7 @@ class dynamic_linked_mat_orderable_state_base {
   IndexG m;
   IndexH n;
   
+  std::unique_ptr<G> g_owned;
   G & g;
   H const & h;
 
@@ -57,18 +62,38 @@ class dynamic_linked_mat_orderable_state_base {
     std::iota(std::begin(index_order_g), std::end(index_order_g), 0);
         
     for (IndexG i=0; i<m; ++i) {
-      for (IndexH j=0; j<n; ++j) {
-        if (vertex_comp(i, j) &&
-            g.out_degree(i) <= h.out_degree(j) &&
-            g.in_degree(i) <= h.in_degree(j)) {
-          M.set(i, j);
-        }
-      }
+      for_each_initial_candidate(g, h, vertex_comp, i, [this, i](IndexH j) {
+        M.set(i, j);
+      });
     }
     M.init();
   }
   
-  dynamic_linked_mat_orderable_state_base(dynamic_linked_mat_orderable_state_base const &) = delete;
+ protected:
+  // a fork reorders its own copy of g in push() and pop()
+  dynamic_linked_mat_orderable_state_base(dynamic_linked_mat_orderable_state_base const & other)
+      : m{other.m},
+        n{other.n},
+        g_owned{std::make_unique<G>(other.g)},
+        g{*g_owned},
+        h{other.h},
+        vertex_comp{other.vertex_comp},
+        edge_comp{other.edge_comp},
+        map(other.map),
+        inv(other.inv),
+        index_order_g(other.index_order_g),
+        x_it{std::next(std::begin(index_order_g), other.x_it - std::cbegin(other.index_order_g))},
+        M(other.M) {
+  }
+  
+ public:
+  embedding_view<IndexG, IndexH> embedding() const {
+    return {map.data(), inv.data(), m, n};
+  }
+
+  IndexG current() const {
+    return *x_it;
+  }
 
   bool empty() const {
     return x_it == std::begin(index_order_g);
@@ -228,6 +253,14 @@ class dynamic_linked_mat_orderable_state_ind
             CompatibilityMatrix>(g, h, vertex_comp, edge_comp) {
   }
   
+ protected:
+  dynamic_linked_mat_orderable_state_ind(dynamic_linked_mat_orderable_state_ind const &) = default;
+  
+ public:
+  dynamic_linked_mat_orderable_state_ind fork() const {
+    return dynamic_linked_mat_orderable_state_ind{*this};
+  }
+  
   bool assign(IndexH y) {
     auto x = *x_it;
     return M.get(x, y);
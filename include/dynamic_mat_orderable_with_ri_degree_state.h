@@ -2,9 +2,13 @@
 #define DYNAMIC_MAT_ORDERABLE_WITH_RI_DEGREE_STATE_H_
 
 #include <iterator>
+#include <memory>
 #include <vector>
 #include <stack>
 
+#include "embedding_view.h"
+#include "initial_candidates.h"
+
 template <
     typename G,
     typename H,
@@ -19,6 +23,7 @@ class dynamic_mat_orderable_with_ri_degree_state_base {
   IndexG m;
   IndexH n;
   
+  std::unique_ptr<G> g_owned;
   G & g;
   H const & h;
 
@@ -34,7 +39,8 @@ class dynamic_mat_orderable_with_ri_degree_state_base {
 
   CompatibilityMatrix M;
   
-  using H_adjacent_vertices_container_type = typename H::adjacent_vertices_container_type;
+  // every vertex of h, the candidates where a pattern vertex has no parent
+  using H_adjacent_vertices_container_type = std::vector<IndexH>;
   H_adjacent_vertices_container_type h_vertices;
 
   std::vector<std::pair<IndexH,bool>> h_parents;
@@ -62,18 +68,40 @@ class dynamic_mat_orderable_with_ri_degree_state_base {
     std::iota(std::begin(index_order_g), std::end(index_order_g), 0);
         
     for (IndexG i=0; i<m; ++i) {
-      for (IndexH j=0; j<n; ++j) {
-        if (vertex_comp(i, j) &&
-            g.out_degree(i) <= h.out_degree(j) &&
-            g.in_degree(i) <= h.in_degree(j)) {
-          M.set(i, j);
-        }
-      }
+      for_each_initial_candidate(g, h, vertex_comp, i, [this, i](IndexH j) {
+        M.set(i, j);
+      });
     }
     std::iota(h_vertices.begin(), h_vertices.end(), 0);
   }
   
-  dynamic_mat_orderable_with_ri_degree_state_base(dynamic_mat_orderable_with_ri_degree_state_base const &) = delete;
+ protected:
+  // a fork reorders its own copy of g in push() and pop()
+  dynamic_mat_orderable_with_ri_degree_state_base(dynamic_mat_orderable_with_ri_degree_state_base const & other)
+      : m{other.m},
+        n{other.n},
+        g_owned{std::make_unique<G>(other.g)},
+        g{*g_owned},
+        h{other.h},
+        vertex_comp{other.vertex_comp},
+        edge_comp{other.edge_comp},
+        map(other.map),
+        inv(other.inv),
+        index_order_g(other.index_order_g),
+        x_it{std::next(std::begin(index_order_g), other.x_it - std::cbegin(other.index_order_g))},
+        M(other.M),
+        h_vertices(other.h_vertices),
+        h_parents(other.h_parents) {
+  }
+  
+ public:
+  embedding_view<IndexG, IndexH> embedding() const {
+    return {map.data(), inv.data(), m, n};
+  }
+
+  IndexG current() const {
+    return *x_it;
+  }
 
   bool empty() const {
     return x_it == std::begin(index_order_g);
@@ -352,6 +380,14 @@ class dynamic_mat_orderable_with_ri_degree_state_ind
     refine();
   }
   
+ protected:
+  dynamic_mat_orderable_with_ri_degree_state_ind(dynamic_mat_orderable_with_ri_degree_state_ind const &) = default;
+  
+ public:
+  dynamic_mat_orderable_with_ri_degree_state_ind fork() const {
+    return dynamic_mat_orderable_with_ri_degree_state_ind{*this};
+  }
+  
   bool assign(IndexH y) {
     auto x = *x_it;
     return M.get(x, y);
@@ -5,6 +5,10 @@
 #include <vector>
 #include <stack>
 
+#include "embedding_view.h"
+#include "alldifferent.h"
+#include "initial_candidates.h"
+
 template <
     typename G,
     typename H,
@@ -33,7 +37,8 @@ class dynamic_mat_state_base {
 
   CompatibilityMatrix M;
   
-  using H_adjacent_vertices_container_type = typename H::adjacent_vertices_container_type;
+  // every vertex of h, the candidates where a pattern vertex has no parent
+  using H_adjacent_vertices_container_type = std::vector<IndexH>;
   H_adjacent_vertices_container_type h_vertices;
 
   std::vector<std::pair<IndexH,bool>> h_parents;
@@ -58,18 +63,24 @@ class dynamic_mat_state_base {
         
     for (IndexG i=0; i<m; ++i) {
       available.insert(i);
-      for (IndexH j=0; j<n; ++j) {
-        if (vertex_comp(i, j) &&
-            g.out_degree(i) <= h.out_degree(j) &&
-            g.in_degree(i) <= h.in_degree(j)) {
-          M.set(i, j);
-        }
-      }
+      for_each_initial_candidate(g, h, vertex_comp, i, [this, i](IndexH j) {
+        M.set(i, j);
+      });
     }
     std::iota(h_vertices.begin(), h_vertices.end(), 0);
   }
   
-  dynamic_mat_state_base(dynamic_mat_state_base const &) = delete;
+ protected:
+  dynamic_mat_state_base(dynamic_mat_state_base const &) = default;
+  
+ public:
+  embedding_view<IndexG, IndexH> embedding() const {
+    return {map.data(), inv.data(), m, n};
+  }
+
+  IndexG current() const {
+    return x_st.top();
+  }
 
   bool empty() const {
     return available.size() == m;
@@ -160,7 +171,8 @@ template <
     typename H,
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate,
-    typename CompatibilityMatrix>
+    typename CompatibilityMatrix,
+    typename AllDifferent = no_alldifferent>
 class dynamic_mat_state_ind
   : public dynamic_mat_state_base<
         G,
@@ -190,6 +202,9 @@ class dynamic_mat_state_ind
   using base::available;
   using base::M;
 
+  AllDifferent D;
+  bool consistent;
+
   void filter_after(IndexG u, IndexH v) {
     for (auto i_it=available.begin(); i_it!=available.end(); ++i_it) {
       auto i = *i_it;
@@ -345,13 +360,24 @@ class dynamic_mat_state_ind
             H,
             VertexEquivalencePredicate,
             EdgeEquivalencePredicate,
-            CompatibilityMatrix>(g, h, vertex_comp, edge_comp) {
+            CompatibilityMatrix>(g, h, vertex_comp, edge_comp),
+        D(m, n),
+        consistent{true} {
     refine();
+    consistent = D.filter(M, map, inv, [this](IndexG i, IndexH j) {M.unset(i, j);});
+  }
+  
+ protected:
+  dynamic_mat_state_ind(dynamic_mat_state_ind const &) = default;
+  
+ public:
+  dynamic_mat_state_ind fork() const {
+    return dynamic_mat_state_ind{*this};
   }
   
   bool assign(IndexH y) {
     auto x = x_st.top();
-    return M.get(x, y);
+    return consistent && M.get(x, y);
   }
   
   void push(IndexH y) {
@@ -362,6 +388,12 @@ class dynamic_mat_state_ind
     //  partial_refine(x, y);
     //}
     base::push(y);
+    consistent = D.filter(M, map, inv, [this](IndexG i, IndexH j) {M.unset(i, j);});
+  }
+  
+  void pop() {
+    consistent = true;
+    base::pop();
   }
 };
 
@@ -2,10 +2,13 @@
 #define DYNAMIC_SORTED_VECTOR_NEW_STATE_H_
 
 #include <iterator>
+#include <memory>
 #include <vector>
 #include <stack>
 
+#include "embedding_view.h"
 #include "sorted_vector.h"
+#include "initial_candidates.h"
 
 template <
     typename G,
@@ -20,6 +23,7 @@ class dynamic_sorted_vector_new_state_base {
   IndexG m;
   IndexH n;
   
+  std::unique_ptr<G> g_owned;
   G & g;
   H const & h;
 
@@ -57,17 +61,38 @@ class dynamic_sorted_vector_new_state_base {
     std::iota(std::begin(index_order_g), std::end(index_order_g), 0);
     
     for (IndexG i=0; i<m; ++i) {
-      for (IndexH j=0; j<n; ++j) {
-        if (vertex_comp(i, j) &&
-            g.out_degree(i) <= h.out_degree(j) &&
-            g.in_degree(i) <= h.in_degree(j)) {
-          M[i].insert(j);
-        }
-      }
+      for_each_initial_candidate(g, h, vertex_comp, i, [this, i](IndexH j) {
+        M[i].insert(j);
+      });
     }
   }
   
-  dynamic_sorted_vector_new_state_base(dynamic_sorted_vector_new_state_base const &) = delete;
+ protected:
+  // a fork reorders its own copy of g in push() and pop()
+  dynamic_sorted_vector_new_state_base(dynamic_sorted_vector_new_state_base const & other)
+      : m{other.m},
+        n{other.n},
+        g_owned{std::make_unique<G>(other.g)},
+        g{*g_owned},
+        h{other.h},
+        vertex_comp{other.vertex_comp},
+        edge_comp{other.edge_comp},
+        index_order_g(other.index_order_g),
+        x_it{std::next(std::begin(index_order_g), other.x_it - std::cbegin(other.index_order_g))},
+        map(other.map),
+        inv(other.inv),
+        M(other.M),
+        changes(other.changes) {
+  }
+  
+ public:
+  embedding_view<IndexG, IndexH> embedding() const {
+    return {map.data(), inv.data(), m, n};
+  }
+
+  IndexG current() const {
+    return *x_it;
+  }
 
   bool empty() const {
     return x_it == std::begin(index_order_g);
@@ -232,6 +257,14 @@ class dynamic_sorted_vector_new_state_ind
             EdgeEquivalencePredicate>(g, h, vertex_comp, edge_comp) {
   }
   
+ protected:
+  dynamic_sorted_vector_new_state_ind(dynamic_sorted_vector_new_state_ind const &) = default;
+  
+ public:
+  dynamic_sorted_vector_new_state_ind fork() const {
+    return dynamic_sorted_vector_new_state_ind{*this};
+  }
+  
   bool assign(IndexH y) {
     return true;
   }
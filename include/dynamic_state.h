@@ -6,6 +6,9 @@
 #include <stack>
 #include <set>
 
+#include "embedding_view.h"
+#include "initial_candidates.h"
+
 template <
     typename G,
     typename H,
@@ -52,17 +55,23 @@ class dynamic_state_base {
         changes(m) {
     for (IndexG i=0; i<m; ++i) {
       available.insert(i);
-      for (IndexH j=0; j<n; ++j) {
-        if (vertex_comp(i, j) &&
-            g.out_degree(i) <= h.out_degree(j) &&
-            g.in_degree(i) <= h.in_degree(j)) {
-          M[i].insert(j);
-        }
-      }
+      for_each_initial_candidate(g, h, vertex_comp, i, [this, i](IndexH j) {
+        M[i].insert(j);
+      });
     }
   }
   
-  dynamic_state_base(dynamic_state_base const &) = delete;
+ protected:
+  dynamic_state_base(dynamic_state_base const &) = default;
+  
+ public:
+  embedding_view<IndexG, IndexH> embedding() const {
+    return {map.data(), inv.data(), m, n};
+  }
+
+  IndexG current() const {
+    return x_st.top();
+  }
 
   bool empty() const {
     return available.size() == m;
@@ -228,6 +237,14 @@ class dynamic_state_ind
             EdgeEquivalencePredicate>(g, h, vertex_comp, edge_comp) {
   }
   
+ protected:
+  dynamic_state_ind(dynamic_state_ind const &) = default;
+  
+ public:
+  dynamic_state_ind fork() const {
+    return dynamic_state_ind{*this};
+  }
+  
   bool assign(IndexH y) {
     return true;
   }
@@ -0,0 +1,53 @@
+#ifndef EMBEDDING_VIEW_H_
+#define EMBEDDING_VIEW_H_
+
+#include <cstddef>
+
+// Read-only window onto a state's current mapping: view[i] is the target
+// vertex of pattern vertex i, inverse(j) the pattern vertex mapped to
+// target vertex j (m if none). Nothing is copied, so a view is only valid
+// until the search moves on.
+template <
+    typename IndexG,
+    typename IndexH>
+class embedding_view {
+ private:
+  IndexH const * map_;
+  IndexG const * inv_;
+  IndexG m;
+  IndexH n;
+
+ public:
+  embedding_view(IndexH const * map, IndexG const * inv, IndexG m, IndexH n)
+      : map_{map},
+        inv_{inv},
+        m{m},
+        n{n} {
+  }
+
+  IndexG size() const {
+    return m;
+  }
+
+  IndexH target_size() const {
+    return n;
+  }
+
+  IndexH operator[](IndexG i) const {
+    return map_[i];
+  }
+
+  IndexG inverse(IndexH j) const {
+    return inv_[j];
+  }
+
+  IndexH const * begin() const {
+    return map_;
+  }
+
+  IndexH const * end() const {
+    return map_ + m;
+  }
+};
+
+#endif  // EMBEDDING_VIEW_H_
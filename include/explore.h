@@ -1,38 +1,59 @@
 #ifndef EXPLORE_H_
 #define EXPLORE_H_
 
+#include <cstddef>
+
+#include "search_limits.h"
+#include "search_statistics.h"
+
+// callback(S.embedding()) is called on every solution, and returns false to
+// stop the search; the view refers to S and is only valid during the call.
 template <
+    typename Statistics = no_statistics,
     typename State,
     typename Callback>
-void explore(State & S, Callback callback = Callback()) {
-  int count = 0;
+search_statistics explore(State & S, Callback callback = Callback(), search_limits * limits = nullptr) {
+  Statistics statistics;
+  limit_checker checker{limits};
   struct explorer {
     State & S;
     Callback callback;
     
-    int & count;
+    Statistics & statistics;
+    limit_checker & checker;
     
-    explorer(State & S, Callback const & callback, int & count)
+    explorer(State & S, Callback const & callback, Statistics & statistics, limit_checker & checker)
         : S{S},
           callback{callback},
-          count{count} {
+          statistics{statistics},
+          checker{checker} {
     }
     
-    bool explore() {
-      ++count;
+    bool explore(std::size_t depth) {
+      if (!checker.node()) {
+        return false;
+      }
+      statistics.node(depth);
       if (S.full()) {
-        return callback(S);
+        if (!checker.solution()) {
+          return false;
+        }
+        statistics.solution();
+        return callback(S.embedding()) && !checker.stopped();
       } else {
-        S.prepare();
+        statistics.template timed<search_phase::prepare>([this] {S.prepare();});
         bool proceed = true;
         for (auto y : S.candidates()) {
-          bool proceed = true;
+          statistics.candidate();
           S.advance();
-          bool success = S.assign(y);
+          bool success = statistics.template timed<search_phase::assign>([this, &y] {return S.assign(y);});
           if (success) {
-            S.push(y);
-            proceed = explore();
-            S.pop();
+            statistics.template timed<search_phase::push>([this, &y] {S.push(y);});
+            statistics.push();
+            proceed = explore(depth+1);
+            statistics.template timed<search_phase::pop>([this] {S.pop();});
+          } else {
+            statistics.assign_failure();
           }
           S.revert();
           if (!proceed) {
@@ -45,9 +66,11 @@ void explore(State & S, Callback callback = Callback()) {
     }
   };
   
-  explorer e{S, callback, count};
-  e.explore();
-  std::cout << "count: " << count << std::endl;
+  explorer e{S, callback, statistics, checker};
+  e.explore(0);
+  search_statistics report = statistics.report();
+  report.limit = checker.hit();
+  return report;
 }
 
 #endif  // EXPLORE_H_
@@ -0,0 +1,187 @@
+#ifndef EXPLORE_CURSOR_H_
+#define EXPLORE_CURSOR_H_
+
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <utility>
+
+#include "search_limits.h"
+
+// explore() turned inside out: the same walk over the State protocol, but
+// with the recursion replaced by an explicit stack of candidate ranges, so
+// that solutions are pulled one at a time and deep patterns do not grow
+// the call stack. next() returns the state sitting on the next solution,
+// valid until the following call, or nullptr once the search is over.
+template <typename State>
+class explore_cursor {
+ private:
+  using range_type = decltype(std::declval<State &>().candidates());
+
+  // candidates() hands out either a range of its own or a reference to one
+  // kept by the state; either is held for as long as its level is open
+  template <typename R>
+  struct range_holder {
+    R range;
+    explicit range_holder(R && range)
+        : range(std::move(range)) {
+    }
+    R & get() {
+      return range;
+    }
+  };
+
+  template <typename R>
+  struct range_holder<R &> {
+    R * range;
+    explicit range_holder(R & range)
+        : range{&range} {
+    }
+    R & get() {
+      return *range;
+    }
+  };
+
+  struct frame {
+    range_holder<range_type> holder;
+    decltype(std::begin(holder.get())) it;
+    decltype(std::end(holder.get())) last;
+
+    explicit frame(range_type && range)
+        : holder(std::forward<range_type>(range)),
+          it{std::begin(holder.get())},
+          last{std::end(holder.get())} {
+    }
+  };
+
+  State & S;
+  limit_checker checker;
+
+  // deque, so that pushing a level never moves the ranges iterated below
+  std::deque<frame> frames;
+  bool started = false;
+  bool done = false;
+
+  // true if the current node is a solution, otherwise opens its level
+  bool enter() {
+    if (S.full()) {
+      return true;
+    }
+    S.prepare();
+    frames.emplace_back(S.candidates());
+    return false;
+  }
+
+  // closes every open level as explore() does when told to stop; pushed
+  // says that the current node was pushed without opening a level
+  State const * finish(bool pushed = false) {
+    if (pushed) {
+      S.pop();
+      S.revert();
+    }
+    while (!frames.empty()) {
+      S.forget();
+      frames.pop_back();
+      if (!frames.empty()) {
+        S.pop();
+        S.revert();
+      }
+    }
+    done = true;
+    return nullptr;
+  }
+
+ public:
+  explicit explore_cursor(State & S, search_limits * limits = nullptr)
+      : S{S},
+        checker{limits} {
+  }
+
+  explore_cursor(explore_cursor const &) = delete;
+  explore_cursor & operator=(explore_cursor const &) = delete;
+
+  State const * next() {
+    if (done) {
+      return nullptr;
+    }
+    if (!started) {
+      started = true;
+      if (!checker.node()) {
+        return finish();
+      }
+      if (enter()) {
+        return checker.solution() ? &S : finish();
+      }
+    } else if (frames.empty()) {
+      // the root itself was the only solution
+      return finish();
+    } else {
+      if (checker.stopped()) {
+        return finish(true);
+      }
+      S.pop();
+      S.revert();
+    }
+
+    while (!frames.empty()) {
+      // the level's position is kept in locals while scanning its
+      // candidates and stored back only when descending
+      auto & f = frames.back();
+      auto it = f.it;
+      auto last = f.last;
+      bool descended = false;
+      while (it != last) {
+        auto y = *it;
+        ++it;
+        S.advance();
+        if (S.assign(y)) {
+          S.push(y);
+          f.it = it;
+          if (!checker.node()) {
+            return finish(true);
+          }
+          if (enter()) {
+            return checker.solution() ? &S : finish(true);
+          }
+          descended = true;
+          break;
+        } else {
+          S.revert();
+        }
+      }
+      if (!descended) {
+        S.forget();
+        frames.pop_back();
+        if (!frames.empty()) {
+          S.pop();
+          S.revert();
+        }
+      }
+    }
+    return finish();
+  }
+
+  // passes up to k further solutions to f and returns how many there were
+  template <typename F>
+  std::size_t next_batch(std::size_t k, F f) {
+    std::size_t produced = 0;
+    for (; produced<k; ++produced) {
+      auto s = next();
+      if (s == nullptr) {
+        break;
+      }
+      f(*s);
+    }
+    return produced;
+  }
+
+  bool exhausted() const {
+    return done;
+  }
+
+  search_limit hit() const {
+    return checker.hit();
+  }
+};
+
+#endif  // EXPLORE_CURSOR_H_
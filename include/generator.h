@@ -0,0 +1,133 @@
+#ifndef GENERATOR_H_
+#define GENERATOR_H_
+
+// C++20: a minimal std::generator stand-in for toolchains without <generator>.
+
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+// Lazily produced sequence of T. A yielded value is referred to, not
+// copied, and stays valid until the iterator is advanced.
+template <typename T>
+class generator {
+ public:
+  struct promise_type {
+    T const * current = nullptr;
+    std::exception_ptr error;
+
+    generator get_return_object() {
+      return generator{std::coroutine_handle<promise_type>::from_promise(*this)};
+    }
+
+    std::suspend_always initial_suspend() noexcept {
+      return {};
+    }
+
+    std::suspend_always final_suspend() noexcept {
+      return {};
+    }
+
+    std::suspend_always yield_value(T const & value) noexcept {
+      current = std::addressof(value);
+      return {};
+    }
+
+    void return_void() {
+    }
+
+    void unhandled_exception() {
+      error = std::current_exception();
+    }
+  };
+
+  struct sentinel {
+  };
+
+  class iterator {
+   private:
+    std::coroutine_handle<promise_type> coroutine;
+
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = T;
+    using reference = T const &;
+    using pointer = T const *;
+
+    iterator() = default;
+
+    explicit iterator(std::coroutine_handle<promise_type> coroutine)
+        : coroutine{coroutine} {
+    }
+
+    reference operator*() const {
+      return *coroutine.promise().current;
+    }
+
+    pointer operator->() const {
+      return coroutine.promise().current;
+    }
+
+    iterator & operator++() {
+      coroutine.resume();
+      if (coroutine.done() && coroutine.promise().error) {
+        std::rethrow_exception(coroutine.promise().error);
+      }
+      return *this;
+    }
+
+    void operator++(int) {
+      ++*this;
+    }
+
+    bool operator==(sentinel) const {
+      return coroutine.done();
+    }
+  };
+
+ private:
+  std::coroutine_handle<promise_type> coroutine;
+
+  explicit generator(std::coroutine_handle<promise_type> coroutine)
+      : coroutine{coroutine} {
+  }
+
+ public:
+  generator(generator && other) noexcept
+      : coroutine{std::exchange(other.coroutine, {})} {
+  }
+
+  generator & operator=(generator && other) noexcept {
+    if (this != &other) {
+      if (coroutine) {
+        coroutine.destroy();
+      }
+      coroutine = std::exchange(other.coroutine, {});
+    }
+    return *this;
+  }
+
+  generator(generator const &) = delete;
+  generator & operator=(generator const &) = delete;
+
+  ~generator() {
+    if (coroutine) {
+      coroutine.destroy();
+    }
+  }
+
+  iterator begin() {
+    iterator it{coroutine};
+    ++it;
+    return it;
+  }
+
+  sentinel end() {
+    return {};
+  }
+};
+
+#endif  // GENERATOR_H_
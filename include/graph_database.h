@@ -0,0 +1,306 @@
+#ifndef GRAPH_DATABASE_H_
+#define GRAPH_DATABASE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "search_limits.h"
+#include "search_statistics.h"
+
+// Features of a graph that any graph containing it, as a subgraph or as an
+// induced subgraph, must dominate: vertex and arc counts, the sorted
+// degree sequences, the label counts and a fingerprint of the labelled,
+// directed simple paths and cycles of up to k arcs hashed into a bitset.
+// Labels are optional; without them every vertex has label 0, and with
+// them vertex_comp is expected to compare exactly these labels.
+//
+// The number of paths grows like n*(3d)^k, so the enumeration stops after
+// fingerprint_budget path steps. A target over budget gets the all-ones
+// fingerprint and a pattern over budget the empty one; either way the
+// fingerprint test passes and the screen stays sound.
+class graph_features {
+ public:
+  static constexpr std::size_t fingerprint_bits = 1024;
+  static constexpr std::uint64_t fingerprint_budget = std::uint64_t{1} << 22;
+
+  using label_type = std::uint32_t;
+
+ private:
+  std::uint64_t n = 0;
+  std::uint64_t arcs = 0;
+  // descending
+  std::vector<std::uint32_t> out_degrees;
+  std::vector<std::uint32_t> in_degrees;
+  // sorted by label
+  std::vector<std::pair<label_type, std::uint32_t>> label_counts;
+  std::array<std::uint64_t, fingerprint_bits/64> fingerprint{};
+
+  // arc direction of one path step: 1 along u->v, 2 along v->u, 3 both
+  using step_code = std::uint8_t;
+
+  static std::uint64_t mix(std::uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111eb;
+    return x ^ (x >> 31);
+  }
+
+  static std::uint64_t extend(std::uint64_t hash, label_type label, step_code code) {
+    return mix(hash + ((static_cast<std::uint64_t>(code) << 32) | label) + 0x9e3779b97f4a7c15);
+  }
+
+  void set(std::uint64_t hash) {
+    auto bit = mix(hash) % fingerprint_bits;
+    fingerprint[bit / 64] |= std::uint64_t{1} << (bit % 64);
+  }
+
+  static bool dominates(std::vector<std::uint32_t> const & big, std::vector<std::uint32_t> const & small) {
+    for (std::size_t i=0; i<small.size(); ++i) {
+      if (small[i] > big[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ public:
+  graph_features() = default;
+
+  // as_target: a pattern step u->v may map onto a target pair joined both
+  // ways, so the target also records every direction a pair allows
+  template <typename G>
+  graph_features(G const & g, label_type const * labels, unsigned k, bool as_target)
+      : n{g.num_vertices()},
+        out_degrees(n),
+        in_degrees(n) {
+    auto label = [labels](std::uint64_t u) -> label_type {
+      return labels != nullptr ? labels[u] : 0;
+    };
+
+    std::vector<std::vector<std::pair<std::uint64_t, step_code>>> steps(n);
+    for (std::uint64_t u=0; u<n; ++u) {
+      for (auto v : g.adjacent_vertices(u)) {
+        ++arcs;
+        ++out_degrees[u];
+        ++in_degrees[v];
+        steps[u].emplace_back(v, 1);
+        steps[v].emplace_back(u, 2);
+      }
+    }
+    for (auto & s : steps) {
+      std::sort(std::begin(s), std::end(s));
+      std::vector<std::pair<std::uint64_t, step_code>> merged;
+      for (auto const & p : s) {
+        if (!merged.empty() && merged.back().first == p.first) {
+          merged.back().second |= p.second;
+        } else {
+          merged.push_back(p);
+        }
+      }
+      s = std::move(merged);
+    }
+
+    std::sort(std::begin(out_degrees), std::end(out_degrees), std::greater<>{});
+    std::sort(std::begin(in_degrees), std::end(in_degrees), std::greater<>{});
+
+    std::vector<label_type> sorted_labels(n);
+    for (std::uint64_t u=0; u<n; ++u) {
+      sorted_labels[u] = label(u);
+    }
+    std::sort(std::begin(sorted_labels), std::end(sorted_labels));
+    for (auto l : sorted_labels) {
+      if (!label_counts.empty() && label_counts.back().first == l) {
+        ++label_counts.back().second;
+      } else {
+        label_counts.emplace_back(l, 1);
+      }
+    }
+
+    // paths are tagged 1, cycles 2
+    std::vector<char> on_path(n);
+    std::uint64_t budget = fingerprint_budget;
+    std::function<void(std::uint64_t, std::uint64_t, std::uint64_t, unsigned)> walk =
+        [&](std::uint64_t start, std::uint64_t u, std::uint64_t hash, unsigned length) {
+      for (auto const & s : steps[u]) {
+        for (step_code code=1; code<=3; ++code) {
+          bool usable = as_target ? (s.second & code) == code : s.second == code;
+          if (!usable) {
+            continue;
+          }
+          if (budget == 0) {
+            return;
+          }
+          --budget;
+          auto next = extend(hash, label(s.first), code);
+          if (s.first == start && length+1 >= 3) {
+            set(next ^ 2);
+          } else if (!on_path[s.first]) {
+            set(next ^ 1);
+            if (length+1 < k) {
+              on_path[s.first] = true;
+              walk(start, s.first, next, length+1);
+              on_path[s.first] = false;
+            }
+          }
+        }
+      }
+    };
+    if (k > 0) {
+      for (std::uint64_t u=0; u<n && budget>0; ++u) {
+        on_path[u] = true;
+        walk(u, u, extend(0, label(u), 0), 0);
+        on_path[u] = false;
+      }
+    }
+    if (budget == 0) {
+      fingerprint.fill(as_target ? ~std::uint64_t{0} : 0);
+    }
+  }
+
+  // false only if a graph with these features cannot contain pattern
+  bool may_contain(graph_features const & pattern) const {
+    if (pattern.n > n || pattern.arcs > arcs) {
+      return false;
+    }
+    if (!dominates(out_degrees, pattern.out_degrees) || !dominates(in_degrees, pattern.in_degrees)) {
+      return false;
+    }
+    auto it = std::begin(label_counts);
+    for (auto const & lc : pattern.label_counts) {
+      it = std::lower_bound(it, std::end(label_counts), lc.first, [](auto const & a, label_type l) {
+        return a.first < l;
+      });
+      if (it == std::end(label_counts) || it->first != lc.first || it->second < lc.second) {
+        return false;
+      }
+    }
+    for (std::size_t w=0; w<fingerprint.size(); ++w) {
+      if (pattern.fingerprint[w] & ~fingerprint[w]) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+struct database_result {
+  // position of the target in the database
+  std::size_t target;
+  std::uint64_t solutions;
+  search_statistics statistics;
+};
+
+// A collection of targets with their features, for one-pattern-against-
+// many-targets queries. Targets whose features rule the pattern out are
+// skipped; the chosen algorithm runs on the survivors only, in parallel.
+template <typename G>
+class graph_database {
+ public:
+  using label_type = graph_features::label_type;
+
+ private:
+  std::vector<G> targets;
+  std::vector<graph_features> features;
+  unsigned k;
+
+  template <typename F>
+  static void parallel_for(std::size_t count, unsigned num_threads, F f) {
+    std::atomic<std::size_t> next{0};
+    auto work = [&]() {
+      for (auto i=next++; i<count; i=next++) {
+        f(i);
+      }
+    };
+    std::vector<std::thread> threads;
+    for (unsigned t=1; t<std::max(num_threads, 1u); ++t) {
+      threads.emplace_back(work);
+    }
+    work();
+    for (auto & thread : threads) {
+      thread.join();
+    }
+  }
+
+ public:
+  // labels, if not empty, holds one label per vertex for every target
+  graph_database(
+      std::vector<G> targets,
+      unsigned k = 3,
+      std::vector<std::vector<label_type>> const & labels = {},
+      unsigned num_threads = std::thread::hardware_concurrency())
+      : targets(std::move(targets)),
+        features(this->targets.size()),
+        k{k} {
+    parallel_for(this->targets.size(), num_threads, [&](std::size_t t) {
+      features[t] = graph_features(this->targets[t], labels.empty() ? nullptr : labels[t].data(), this->k, true);
+    });
+  }
+
+  std::size_t size() const {
+    return targets.size();
+  }
+
+  G const & target(std::size_t t) const {
+    return targets[t];
+  }
+
+  // targets that may contain pattern, in database order
+  template <typename P>
+  std::vector<std::size_t> screen(P const & pattern, label_type const * labels = nullptr) const {
+    graph_features pf(pattern, labels, k, false);
+    std::vector<std::size_t> survivors;
+    for (std::size_t t=0; t<targets.size(); ++t) {
+      if (features[t].may_contain(pf)) {
+        survivors.push_back(t);
+      }
+    }
+    return survivors;
+  }
+
+  // Screens, then runs algorithm(pattern, target, callback, vertex_comp,
+  // edge_comp, limits), e.g. PORTFOLIO_ALGORITHM(ri_ind), on every
+  // survivor. on_result gets one database_result per survivor, under a
+  // lock, in completion order. Returns the number of survivors.
+  template <
+      typename P,
+      typename Algorithm,
+      typename VertexEquivalencePredicate,
+      typename EdgeEquivalencePredicate,
+      typename OnResult>
+  std::size_t match(
+      P const & pattern,
+      Algorithm algorithm,
+      VertexEquivalencePredicate vertex_comp,
+      EdgeEquivalencePredicate edge_comp,
+      OnResult on_result,
+      label_type const * labels = nullptr,
+      unsigned num_threads = std::thread::hardware_concurrency()) const {
+    auto survivors = screen(pattern, labels);
+    std::mutex mutex;
+    parallel_for(survivors.size(), num_threads, [&](std::size_t i) {
+      auto t = survivors[i];
+      std::uint64_t solutions = 0;
+      auto count = [&solutions](auto const &) {
+        ++solutions;
+        return true;
+      };
+      search_limits * no_limits = nullptr;
+      auto statistics = algorithm(pattern, targets[t], count, vertex_comp, edge_comp, no_limits);
+
+      std::lock_guard<std::mutex> lock{mutex};
+      on_result(database_result{t, solutions, statistics});
+    });
+    return survivors.size();
+  }
+};
+
+#endif  // GRAPH_DATABASE_H_
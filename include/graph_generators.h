@@ -0,0 +1,261 @@
+#ifndef GRAPH_GENERATORS_H_
+#define GRAPH_GENERATORS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+// Seeded random graphs for benchmarks. Every generator builds its graph
+// through G(n) and add_edge(u, v) like read_amalfi; undirected graphs get
+// both arcs. Draws go through generator_rng instead of the std
+// distributions, whose output differs between standard libraries, so a
+// seed names the same graph everywhere.
+
+class generator_rng {
+ private:
+  std::mt19937_64 engine;
+
+ public:
+  explicit generator_rng(std::uint64_t seed)
+      : engine{seed} {
+  }
+
+  // uniform in [0, n)
+  std::uint64_t below(std::uint64_t n) {
+    auto const max = std::numeric_limits<std::uint64_t>::max();
+    auto const limit = max - max % n;
+    std::uint64_t x;
+    do {
+      x = engine();
+    } while (x >= limit);
+    return x % n;
+  }
+
+  // uniform in [0, 1)
+  double real() {
+    return (engine() >> 11) * 0x1.0p-53;
+  }
+
+  bool bernoulli(double p) {
+    return real() < p;
+  }
+
+  template <typename T>
+  void shuffle(std::vector<T> & v) {
+    for (auto k=v.size(); k>1; --k) {
+      std::swap(v[k-1], v[below(k)]);
+    }
+  }
+};
+
+// G(n, p): every ordered (directed) or unordered pair is an edge with
+// probability p. Gaps between edges are drawn geometrically, so the cost
+// is proportional to the number of edges rather than n^2.
+template <typename G>
+G erdos_renyi(std::uint64_t n, double p, generator_rng & rng, bool directed = false) {
+  G g(n);
+  if (p <= 0 || n < 2) {
+    return g;
+  }
+  auto const log_q = std::log1p(-std::min(p, 1.0 - 1e-16));
+  auto skip = [&]() -> std::uint64_t {
+    return p >= 1 ? 0 : std::floor(std::log1p(-rng.real()) / log_q);
+  };
+  if (directed) {
+    // pair k is (k / (n-1), k % (n-1)) with the diagonal left out
+    auto const pairs = n * (n-1);
+    for (auto k=skip(); k<pairs; k+=1+skip()) {
+      auto u = k / (n-1);
+      auto v = k % (n-1);
+      g.add_edge(u, v < u ? v : v+1);
+    }
+  } else {
+    std::uint64_t u = 1, v = 0;
+    for (auto s=skip();; s=skip()) {
+      v += s;
+      while (u < n && v >= u) {
+        v -= u;
+        ++u;
+      }
+      if (u >= n) {
+        break;
+      }
+      g.add_edge(u, v);
+      g.add_edge(v, u);
+      ++v;
+    }
+  }
+  return g;
+}
+
+// Preferential attachment: vertex v >= m joins with m edges to distinct
+// earlier vertices chosen proportionally to their degree. The first new
+// vertex connects to all of 0..m-1.
+template <typename G>
+G barabasi_albert(std::uint64_t n, std::uint64_t m, generator_rng & rng) {
+  G g(n);
+  m = std::max<std::uint64_t>(m, 1);
+  // every vertex appears here once per incident edge
+  std::vector<std::uint64_t> ends;
+  std::vector<std::uint64_t> targets;
+  for (std::uint64_t v=m; v<n; ++v) {
+    targets.clear();
+    if (v == m) {
+      for (std::uint64_t u=0; u<m; ++u) {
+        targets.push_back(u);
+      }
+    } else {
+      while (targets.size() < m) {
+        auto u = ends[rng.below(ends.size())];
+        if (std::find(std::begin(targets), std::end(targets), u) == std::end(targets)) {
+          targets.push_back(u);
+        }
+      }
+    }
+    for (auto u : targets) {
+      g.add_edge(u, v);
+      g.add_edge(v, u);
+      ends.push_back(u);
+      ends.push_back(v);
+    }
+  }
+  return g;
+}
+
+// w x h x d grid with edges between orthogonal neighbours; d = 1 gives
+// the 2D mesh. Vertex (x, y, z) is x + w*(y + h*z).
+template <typename G>
+G mesh(std::uint64_t w, std::uint64_t h, std::uint64_t d = 1) {
+  G g(w*h*d);
+  auto id = [w, h](std::uint64_t x, std::uint64_t y, std::uint64_t z) {
+    return x + w*(y + h*z);
+  };
+  auto connect = [&g](std::uint64_t u, std::uint64_t v) {
+    g.add_edge(u, v);
+    g.add_edge(v, u);
+  };
+  for (std::uint64_t z=0; z<d; ++z) {
+    for (std::uint64_t y=0; y<h; ++y) {
+      for (std::uint64_t x=0; x<w; ++x) {
+        if (x+1 < w) {
+          connect(id(x, y, z), id(x+1, y, z));
+        }
+        if (y+1 < h) {
+          connect(id(x, y, z), id(x, y+1, z));
+        }
+        if (z+1 < d) {
+          connect(id(x, y, z), id(x, y, z+1));
+        }
+      }
+    }
+  }
+  return g;
+}
+
+// Undirected graph in which no vertex has more than valence neighbours:
+// random pairs are joined while both ends have room, aiming at
+// n*valence/2 edges, and the attempt stops after a bounded number of
+// rejected draws.
+template <typename G>
+G bounded_valence(std::uint64_t n, std::uint64_t valence, generator_rng & rng) {
+  G g(n);
+  if (n < 2) {
+    return g;
+  }
+  std::vector<std::uint64_t> degree(n);
+  std::set<std::pair<std::uint64_t, std::uint64_t>> edges;
+  auto const wanted = n * valence / 2;
+  for (std::uint64_t tries=0; edges.size()<wanted && tries<10*wanted; ++tries) {
+    auto u = rng.below(n);
+    auto v = rng.below(n);
+    if (u == v || degree[u] >= valence || degree[v] >= valence) {
+      continue;
+    }
+    if (edges.emplace(std::min(u, v), std::max(u, v)).second) {
+      g.add_edge(u, v);
+      g.add_edge(v, u);
+      ++degree[u];
+      ++degree[v];
+    }
+  }
+  return g;
+}
+
+// Connected pattern with k vertices taken from h, connectivity ignoring
+// edge direction. The vertex set grows from a random vertex through random
+// frontier edges and is relabelled randomly. Induced keeps every arc of h
+// between the chosen vertices, so the pattern has an induced embedding in
+// h; otherwise the arcs that grew the set are kept and each remaining one
+// survives with probability keep, which leaves a monomorphism only.
+// Returns fewer than k vertices if the component drawn is smaller.
+template <
+    typename G,
+    typename H>
+G random_pattern(H const & h, std::uint64_t k, bool induced, generator_rng & rng, double keep = 0.5) {
+  std::uint64_t n = h.num_vertices();
+  if (n == 0 || k == 0) {
+    return G(0);
+  }
+
+  // undirected view of h
+  std::vector<std::vector<std::uint64_t>> nbrs(n);
+  for (std::uint64_t u=0; u<n; ++u) {
+    for (auto v : h.adjacent_vertices(u)) {
+      nbrs[u].push_back(v);
+      nbrs[v].push_back(u);
+    }
+  }
+
+  auto const none = std::numeric_limits<std::uint64_t>::max();
+  std::vector<std::uint64_t> local(n, none);
+  std::vector<std::uint64_t> chosen;
+  std::set<std::pair<std::uint64_t, std::uint64_t>> tree;
+  std::vector<std::pair<std::uint64_t, std::uint64_t>> frontier;
+  auto choose = [&](std::uint64_t u) {
+    local[u] = chosen.size();
+    chosen.push_back(u);
+    for (auto v : nbrs[u]) {
+      if (local[v] == none) {
+        frontier.emplace_back(u, v);
+      }
+    }
+  };
+  choose(rng.below(n));
+  while (chosen.size() < k && !frontier.empty()) {
+    auto f = rng.below(frontier.size());
+    auto e = frontier[f];
+    frontier[f] = frontier.back();
+    frontier.pop_back();
+    if (local[e.second] == none) {
+      tree.emplace(std::min(e.first, e.second), std::max(e.first, e.second));
+      choose(e.second);
+    }
+  }
+
+  std::vector<std::uint64_t> label(chosen.size());
+  for (std::uint64_t i=0; i<label.size(); ++i) {
+    label[i] = i;
+  }
+  rng.shuffle(label);
+
+  G g(chosen.size());
+  for (auto u : chosen) {
+    for (auto v : h.adjacent_vertices(u)) {
+      if (local[v] == none) {
+        continue;
+      }
+      if (induced || tree.count({std::min<std::uint64_t>(u, v), std::max<std::uint64_t>(u, v)}) || rng.bernoulli(keep)) {
+        g.add_edge(label[local[u]], label[local[v]]);
+      }
+    }
+  }
+  return g;
+}
+
+#endif  // GRAPH_GENERATORS_H_
@@ -1,6 +1,12 @@
 #ifndef GRAPH_TRAITS_H_
 #define GRAPH_TRAITS_H_
 
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+#include <boost/range/iterator_range.hpp>
+
 struct direction_category_tag {};
 struct directed_tag : public direction_category_tag {};
 struct undirected_tag : public direction_category_tag {};
@@ -13,4 +19,11 @@ struct is_directed {
     static constexpr bool value = std::is_base_of<directed_tag, D>::value;
 };
 
+// A contiguous list of vertices, a std::vector or a row of a CSR graph, as
+// a range of pointers, so that either can be handed out as candidates.
+template <typename C>
+auto vertex_range(C const & c) {
+  return boost::make_iterator_range(std::to_address(std::begin(c)), std::to_address(std::end(c)));
+}
+
 #endif  // GRAPH_TRAITS_H_
@@ -62,6 +62,15 @@ class index_heap {
     std::iota(std::begin(pos), std::end(pos), 0);
   }
   
+  index_heap(
+      index_heap const & other,
+      Compare const & compare)
+      : heap(other.heap),
+        pos(other.pos),
+        compare{compare},
+        count{other.count} {
+  }
+  
   void heapify() {
     for (Index i=count/2-1; i >= 0; --i) {
       trickle_down(i);
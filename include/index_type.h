@@ -0,0 +1,21 @@
+#ifndef INDEX_TYPE_H_
+#define INDEX_TYPE_H_
+
+#include <cstdint>
+#include <limits>
+
+// Calls f with a value of the narrowest unsigned type that can index n
+// vertices, keeping n itself free as the "unmapped" sentinel the states
+// use. Small graphs keep their 16-bit adjacency lists and matrices.
+template <typename F>
+decltype(auto) with_index_type(std::uint64_t n, F && f) {
+  if (n < std::numeric_limits<std::uint16_t>::max()) {
+    return f(std::uint16_t{});
+  } else if (n < std::numeric_limits<std::uint32_t>::max()) {
+    return f(std::uint32_t{});
+  } else {
+    return f(std::uint64_t{});
+  }
+}
+
+#endif  // INDEX_TYPE_H_
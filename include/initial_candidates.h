@@ -0,0 +1,32 @@
+#ifndef INITIAL_CANDIDATES_H_
+#define INITIAL_CANDIDATES_H_
+
+// Calls f(j) for every target vertex j that pattern vertex i starts out
+// with. The predicate of an initial_domain hands out the set bits of row
+// i, which have passed the degree tests already; any other vertex_comp is
+// tried against every j, followed by the degree tests.
+template <
+    typename G,
+    typename H,
+    typename VertexEquivalencePredicate,
+    typename F>
+void for_each_initial_candidate(
+    G const & g,
+    H const & h,
+    VertexEquivalencePredicate const & vertex_comp,
+    typename G::index_type i,
+    F f) {
+  if constexpr (requires { vertex_comp.for_each(i, f); }) {
+    vertex_comp.for_each(i, f);
+  } else {
+    for (typename H::index_type j=0; j<h.num_vertices(); ++j) {
+      if (vertex_comp(i, j) &&
+          g.out_degree(i) <= h.out_degree(j) &&
+          g.in_degree(i) <= h.in_degree(j)) {
+        f(j);
+      }
+    }
+  }
+}
+
+#endif  // INITIAL_CANDIDATES_H_
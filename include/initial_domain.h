@@ -0,0 +1,122 @@
+#ifndef INITIAL_DOMAIN_H_
+#define INITIAL_DOMAIN_H_
+
+#include <cstddef>
+#include <bit>
+
+#include "bit_row.h"
+#include "degree_buckets.h"
+#include "neighborhood_signature.h"
+#include "prepared_target.h"
+#include "scratch_arena.h"
+#include "search_limits.h"
+
+// The pairs (i, j) that survive vertex_comp and the signature tests, one
+// bit row per pattern vertex. Row i only looks at the target vertices of
+// at least the degree of i, a prefix of the degree buckets of h. Every
+// predefined.h algorithm builds this once and hands its states predicate()
+// in place of vertex_comp. The states fill their initial compatibility from
+// its rows through for_each_initial_candidate, and the vertex_comp checks
+// of the search become bit tests.
+// The predicate refers to the domain, which must outlive the states.
+// If limits is given, its cancel flag is polled once per pattern vertex;
+// a cancelled build leaves the remaining rows empty, so that a search
+// cancelled while still preprocessing stops at its root.
+template <
+    typename IndexG,
+    typename IndexH>
+class initial_domain {
+ private:
+  IndexG m;
+  IndexH n;
+  std::size_t words;
+  scratch_vector<bit_word> bits;
+
+ public:
+  class predicate_type {
+   private:
+    initial_domain const * D;
+
+   public:
+    explicit predicate_type(initial_domain const & D)
+        : D{&D} {
+    }
+
+    bool operator()(IndexG i, IndexH j) const {
+      return D->get(i, j);
+    }
+
+    template <typename F>
+    void for_each(IndexG i, F f) const {
+      D->for_each(i, f);
+    }
+  };
+
+  template <typename VertexEquivalencePredicate>
+  initial_domain(
+      neighborhood_signature<IndexG> const & gs,
+      neighborhood_signature<IndexH> const & hs,
+      degree_buckets<IndexH> const & hb,
+      VertexEquivalencePredicate vertex_comp,
+      search_limits const * limits = nullptr)
+      : m{gs.num_vertices()},
+        n{hs.num_vertices()},
+        words{bit_row_words(n)},
+        bits(static_cast<std::size_t>(m) * words) {
+    for (IndexG i=0; i<m; ++i) {
+      if (limits != nullptr && limits->cancel.load(std::memory_order_relaxed)) {
+        break;
+      }
+      auto row = bits.data() + static_cast<std::size_t>(i)*words;
+      for (auto j : hb.at_least(gs.out_degree(i) + gs.in_degree(i))) {
+        if (signature_compatible(gs, i, hs, j) && vertex_comp(i, j)) {
+          row[j / bit_word_bits] |= static_cast<bit_word>(1) << (j % bit_word_bits);
+        }
+      }
+    }
+  }
+
+  bool get(IndexG i, IndexH j) const {
+    return bit_row_test(bits.data() + static_cast<std::size_t>(i)*words, j);
+  }
+
+  // calls f(j) for every j of row i, in increasing order, a word at a time
+  template <typename F>
+  void for_each(IndexG i, F f) const {
+    auto row = bits.data() + static_cast<std::size_t>(i)*words;
+    for (std::size_t k=0; k<words; ++k) {
+      for (auto w=row[k]; w!=0; w&=w-1) {
+        f(static_cast<IndexH>(k*bit_word_bits + std::countr_zero(w)));
+      }
+    }
+  }
+
+  std::size_t num_candidates(IndexG i) const {
+    return bit_row_count(bits.data() + static_cast<std::size_t>(i)*words, words);
+  }
+
+  predicate_type predicate() const {
+    return predicate_type{*this};
+  }
+};
+
+// The domain of g_ in h_, with the signature and degree buckets of h_
+// taken from h_ if it is a prepared_target.
+template <
+    typename G_,
+    typename H_,
+    typename VertexEquivalencePredicate>
+initial_domain<typename G_::index_type, typename H_::index_type> make_initial_domain(
+    G_ const & g_,
+    H_ const & h_,
+    VertexEquivalencePredicate vertex_comp,
+    search_limits const * limits = nullptr) {
+  using HS = neighborhood_signature<typename H_::index_type>;
+  using HB = degree_buckets<typename H_::index_type>;
+  neighborhood_signature<typename G_::index_type> gs{g_};
+  HS const & hs = target_representation<HS>(h_);
+  HB const & hb = target_representation<HB>(h_);
+  return {gs, hs, hb, vertex_comp, limits};
+}
+
+#endif  // INITIAL_DOMAIN_H_
@@ -0,0 +1,201 @@
+#ifndef MAPPED_AMALFI_H_
+#define MAPPED_AMALFI_H_
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <filesystem>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "csr_adjacency_list.h"
+
+// Read-only mapping of a whole file, unmapped on destruction.
+class mapped_file {
+ private:
+  unsigned char const * data_ = nullptr;
+  std::size_t size_ = 0;
+
+ public:
+  explicit mapped_file(char const * filename) {
+    int fd = ::open(filename, O_RDONLY);
+    if (fd < 0) {
+      throw std::system_error(errno, std::generic_category(), filename);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) < 0) {
+      auto err = errno;
+      ::close(fd);
+      throw std::system_error(err, std::generic_category(), filename);
+    }
+    size_ = st.st_size;
+    if (size_ > 0) {
+      void * p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (p == MAP_FAILED) {
+        auto err = errno;
+        ::close(fd);
+        throw std::system_error(err, std::generic_category(), filename);
+      }
+      ::madvise(p, size_, MADV_SEQUENTIAL);
+      data_ = static_cast<unsigned char const *>(p);
+    }
+    ::close(fd);
+  }
+
+  mapped_file(mapped_file const &) = delete;
+  mapped_file & operator=(mapped_file const &) = delete;
+
+  ~mapped_file() {
+    if (data_) {
+      ::munmap(const_cast<unsigned char *>(data_), size_);
+    }
+  }
+
+  unsigned char const * data() const {
+    return data_;
+  }
+  std::size_t size() const {
+    return size_;
+  }
+};
+
+// little-endian word at p
+template <typename Word>
+Word load_word(unsigned char const * p) {
+  Word x = 0;
+  for (unsigned b=0; b<sizeof(Word); ++b) {
+    x |= static_cast<Word>(p[b]) << (8*b);
+  }
+  return x;
+}
+
+// Parses an AMALFI image straight into CSR. A first pass hops from count to
+// count to size the rows exactly, the second converts each row of ids in
+// one sweep. With verify, a truncated file or an id >= n throws instead of
+// reading out of bounds; without it, an image too short to hold the vertex
+// count parses as the empty graph.
+template <
+    typename Index,
+    typename Word = uint16_t>
+csr_adjacency_list<Index> parse_amalfi_csr(unsigned char const * data, std::size_t size, bool verify = false) {
+  auto const num_words = size / sizeof(Word);
+  auto word = [data](std::size_t w) {
+    return load_word<Word>(data + w*sizeof(Word));
+  };
+
+  if (num_words < 1) {
+    if (verify) {
+      throw std::runtime_error("amalfi: missing vertex count");
+    }
+    return {0, std::vector<std::size_t>(1), {}};
+  }
+  Index n = word(0);
+  // every vertex takes at least its count word
+  if (verify && static_cast<std::size_t>(n) > num_words - 1) {
+    throw std::runtime_error("amalfi: truncated edge count");
+  }
+
+  std::vector<std::size_t> out_off(static_cast<std::size_t>(n)+1);
+  std::size_t w = 1;
+  for (Index u=0; u<n; ++u) {
+    if (verify && w >= num_words) {
+      throw std::runtime_error("amalfi: truncated edge count");
+    }
+    auto cnt = word(w);
+    if (verify && cnt > num_words - w - 1) {
+      throw std::runtime_error("amalfi: truncated edge list");
+    }
+    out_off[u+1] = out_off[u] + cnt;
+    w += 1 + std::size_t{cnt};
+  }
+
+  std::vector<Index> out_adj(out_off[n]);
+  w = 1;
+  for (Index u=0; u<n; ++u) {
+    auto row = data + (w+1)*sizeof(Word);
+    auto cnt = out_off[u+1] - out_off[u];
+    auto out = out_adj.data() + out_off[u];
+    for (std::size_t k=0; k<cnt; ++k) {
+      auto v = load_word<Word>(row + k*sizeof(Word));
+      if (verify && v >= n) {
+        throw std::runtime_error("amalfi: vertex id out of range");
+      }
+      out[k] = v;
+    }
+    w += 1 + cnt;
+  }
+
+  return {n, std::move(out_off), std::move(out_adj)};
+}
+
+template <
+    typename Index,
+    typename Word = uint16_t>
+csr_adjacency_list<Index> read_amalfi_mapped(char const * filename, bool verify = false) {
+  mapped_file file{filename};
+  return parse_amalfi_csr<Index, Word>(file.data(), file.size(), verify);
+}
+
+// Loads every regular file in dir on num_threads threads. The result is
+// sorted by path.
+template <
+    typename Index,
+    typename Word = uint16_t>
+std::vector<std::pair<std::string, csr_adjacency_list<Index>>> read_amalfi_directory(
+    std::string const & dir,
+    unsigned num_threads = std::thread::hardware_concurrency(),
+    bool verify = false) {
+  std::vector<std::string> paths;
+  for (auto const & entry : std::filesystem::directory_iterator(dir)) {
+    if (entry.is_regular_file()) {
+      paths.push_back(entry.path().string());
+    }
+  }
+  std::sort(std::begin(paths), std::end(paths));
+
+  std::vector<std::optional<csr_adjacency_list<Index>>> slots(paths.size());
+  std::vector<std::exception_ptr> errors(paths.size());
+  std::atomic<std::size_t> next{0};
+  auto work = [&]() {
+    for (auto k=next++; k<paths.size(); k=next++) {
+      try {
+        slots[k].emplace(read_amalfi_mapped<Index, Word>(paths[k].c_str(), verify));
+      } catch (...) {
+        errors[k] = std::current_exception();
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for (unsigned t=1; t<std::max(num_threads, 1u); ++t) {
+    threads.emplace_back(work);
+  }
+  work();
+  for (auto & thread : threads) {
+    thread.join();
+  }
+
+  std::vector<std::pair<std::string, csr_adjacency_list<Index>>> graphs;
+  graphs.reserve(paths.size());
+  for (std::size_t k=0; k<paths.size(); ++k) {
+    if (errors[k]) {
+      std::rethrow_exception(errors[k]);
+    }
+    graphs.emplace_back(std::move(paths[k]), std::move(*slots[k]));
+  }
+  return graphs;
+}
+
+#endif  // MAPPED_AMALFI_H_
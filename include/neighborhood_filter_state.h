@@ -8,6 +8,9 @@
 #include <boost/range/iterator_range.hpp>
 #include <boost/range/adaptor/filtered.hpp>
 
+#include "embedding_view.h"
+#include "initial_candidates.h"
+
 template <
     typename G,
     typename H,
@@ -56,17 +59,23 @@ class neighborhood_filter_state_base {
         map(m, n),
         inv(n, m) {
     for (IndexG i=0; i<m; ++i) {
-      for (IndexH j=0; j<n; ++j) {
-        if (vertex_comp(i, j) &&
-            g.out_degree(i) <= h.out_degree(j) &&
-            g.in_degree(i) <= h.in_degree(j)) {
-          M.set(i, j);
-        }
-      }
+      for_each_initial_candidate(g, h, vertex_comp, i, [this, i](IndexH j) {
+        M.set(i, j);
+      });
     }
   }
   
-  neighborhood_filter_state_base(neighborhood_filter_state_base const &) = delete;
+ protected:
+  neighborhood_filter_state_base(neighborhood_filter_state_base const &) = default;
+  
+ public:
+  embedding_view<IndexG, IndexH> embedding() const {
+    return {map.data(), inv.data(), m, n};
+  }
+
+  IndexG current() const {
+    return *x_it;
+  }
 
   bool empty() const {
     return x_it == std::begin(index_order_g);
@@ -198,6 +207,14 @@ class neighborhood_filter_state_ind
             IndexOrderG>(g, h, vertex_comp, edge_comp, index_order_g) {
   }
   
+ protected:
+  neighborhood_filter_state_ind(neighborhood_filter_state_ind const &) = default;
+  
+ public:
+  neighborhood_filter_state_ind fork() const {
+    return neighborhood_filter_state_ind{*this};
+  }
+  
   bool assign(IndexH y) {
     return true;
   }
@@ -0,0 +1,164 @@
+#ifndef NEIGHBORHOOD_SIGNATURE_H_
+#define NEIGHBORHOOD_SIGNATURE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+// Vertex invariants that an embedding can only increase: out- and
+// in-degree, and the degrees (out plus in) of the distinct neighbours in
+// decreasing order. Only adjacent_vertices() of the graph is used, so any
+// input graph will do.
+template <typename Index>
+class neighborhood_signature {
+ public:
+  using index_type = Index;
+  using degree_type = std::uint32_t;
+
+ private:
+  index_type n;
+
+  std::vector<degree_type> out_degrees;
+  std::vector<degree_type> in_degrees;
+
+  std::vector<std::size_t> offsets;
+  std::vector<degree_type> degrees;
+
+ public:
+  template <typename G>
+  explicit neighborhood_signature(G const & g)
+      : n{g.num_vertices()},
+        out_degrees(n),
+        in_degrees(n),
+        offsets(n+1) {
+    std::vector<std::size_t> nb_offsets(n+1);
+    for (index_type u=0; u<n; ++u) {
+      for (auto v : g.adjacent_vertices(u)) {
+        ++out_degrees[u];
+        ++in_degrees[v];
+        if (u != v) {
+          ++nb_offsets[u+1];
+          ++nb_offsets[v+1];
+        }
+      }
+    }
+    for (index_type u=0; u<n; ++u) {
+      nb_offsets[u+1] += nb_offsets[u];
+    }
+    std::vector<index_type> nb(nb_offsets[n]);
+    {
+      auto fill = nb_offsets;
+      for (index_type u=0; u<n; ++u) {
+        for (auto v : g.adjacent_vertices(u)) {
+          if (u != v) {
+            nb[fill[u]++] = v;
+            nb[fill[v]++] = u;
+          }
+        }
+      }
+    }
+
+    // both directions of an edge and parallel edges give one neighbour
+    std::size_t size = 0;
+    for (index_type u=0; u<n; ++u) {
+      auto first = nb_offsets[u];
+      auto last = nb_offsets[u+1];
+      std::sort(std::begin(nb) + first, std::begin(nb) + last);
+      nb_offsets[u] = size;
+      for (auto k=first; k<last; ++k) {
+        if (k == first || nb[k] != nb[k-1]) {
+          nb[size++] = nb[k];
+        }
+      }
+    }
+    nb_offsets[n] = size;
+    nb.resize(size);
+
+    degrees.resize(size);
+    for (index_type u=0; u<n; ++u) {
+      offsets[u] = nb_offsets[u];
+      for (auto k=nb_offsets[u]; k<nb_offsets[u+1]; ++k) {
+        degrees[k] = out_degrees[nb[k]] + in_degrees[nb[k]];
+      }
+      std::sort(
+          std::begin(degrees) + nb_offsets[u],
+          std::begin(degrees) + nb_offsets[u+1],
+          std::greater<degree_type>{});
+    }
+    offsets[n] = size;
+  }
+
+  index_type num_vertices() const {
+    return n;
+  }
+
+  degree_type out_degree(index_type u) const {
+    return out_degrees[u];
+  }
+
+  degree_type in_degree(index_type u) const {
+    return in_degrees[u];
+  }
+
+  std::size_t num_neighbors(index_type u) const {
+    return offsets[u+1] - offsets[u];
+  }
+
+  degree_type const * neighbor_degrees(index_type u) const {
+    return degrees.data() + offsets[u];
+  }
+};
+
+// a[k] <= b[k] for every k < size
+inline bool degree_sequence_dominated(std::uint32_t const * a, std::uint32_t const * b, std::size_t size) {
+  std::size_t k = 0;
+#if defined(__AVX512F__)
+  for (; k+16<=size; k+=16) {
+    if (_mm512_cmpgt_epu32_mask(_mm512_loadu_si512(a + k), _mm512_loadu_si512(b + k))) {
+      return false;
+    }
+  }
+#elif defined(__AVX2__)
+  // degrees stay far below 2^31, so the signed comparison is enough
+  for (; k+8<=size; k+=8) {
+    auto va = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(a + k));
+    auto vb = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(b + k));
+    auto gt = _mm256_cmpgt_epi32(va, vb);
+    if (!_mm256_testz_si256(gt, gt)) {
+      return false;
+    }
+  }
+#endif
+  for (; k<size; ++k) {
+    if (a[k] > b[k]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// whether pattern vertex i may be mapped to target vertex j as far as the
+// signatures can tell
+template <
+    typename IndexG,
+    typename IndexH>
+bool signature_compatible(
+    neighborhood_signature<IndexG> const & gs,
+    IndexG i,
+    neighborhood_signature<IndexH> const & hs,
+    IndexH j) {
+  if (gs.out_degree(i) > hs.out_degree(j) ||
+      gs.in_degree(i) > hs.in_degree(j) ||
+      gs.num_neighbors(i) > hs.num_neighbors(j)) {
+    return false;
+  }
+  return degree_sequence_dominated(gs.neighbor_degrees(i), hs.neighbor_degrees(j), gs.num_neighbors(i));
+}
+
+#endif  // NEIGHBORHOOD_SIGNATURE_H_
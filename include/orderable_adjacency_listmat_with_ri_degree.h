@@ -1,6 +1,7 @@
 #ifndef ORDERABLE_ADJACENCY_LISTMAT_WITH_RI_DEGREE_H_
 #define ORDERABLE_ADJACENCY_LISTMAT_WITH_RI_DEGREE_H_
 
+#include <cstddef>
 #include <iterator>
 #include <algorithm>
 #include <vector>
@@ -29,6 +30,15 @@ class orderable_adjacency_listmat_with_ri_degree {
     iterator out_mid;
     iterator in_mid;
     
+    node() = default;
+    
+    node(node const & other)
+        : out(other.out),
+          in(other.in),
+          out_mid{std::next(std::begin(out), other.out_cmid() - std::cbegin(other.out))},
+          in_mid{std::next(std::begin(in), other.in_cmid() - std::cbegin(other.in))} {
+    }
+    
     const_iterator out_cmid() const {
       return out_mid;
     }
@@ -41,11 +51,11 @@ class orderable_adjacency_listmat_with_ri_degree {
   std::vector<bool> mat;
   
   void set(index_type i, index_type j) {
-    mat[i*n + j] = true;
+    mat[static_cast<std::size_t>(i)*n + j] = true;
   }
   
   bool get(index_type i, index_type j) const {
-    return mat[i*n + j];
+    return mat[static_cast<std::size_t>(i)*n + j];
   }
   
  public:
@@ -53,7 +63,7 @@ class orderable_adjacency_listmat_with_ri_degree {
   explicit orderable_adjacency_listmat_with_ri_degree(G const & g)
       : n{g.num_vertices()},
         nodes(n),
-        mat(n * n) {
+        mat(static_cast<std::size_t>(n)*n) {
     for (index_type u=0; u<n; ++u) {
       for (auto v : g.adjacent_vertices(u)) {
         set(u, v);
@@ -1,6 +1,7 @@
 #ifndef ORDRED_ADJACENCY_LISTMAT_WITH_NOT_AFTER_H_
 #define ORDRED_ADJACENCY_LISTMAT_WITH_NOT_AFTER_H_
 
+#include <cstddef>
 #include <vector>
 
 #include <boost/range/iterator_range.hpp>
@@ -30,11 +31,11 @@ class ordered_adjacency_listmat_with_not_after {
   std::vector<bool> mat;
   
   void set(index_type i, index_type j) {
-    mat[i*n + j] = true;
+    mat[static_cast<std::size_t>(i)*n + j] = true;
   }
   
   bool get(index_type i, index_type j) const {
-    return mat[i*n + j];
+    return mat[static_cast<std::size_t>(i)*n + j];
   }
   
  public:
@@ -46,7 +47,7 @@ class ordered_adjacency_listmat_with_not_after {
       IndexOrder const & index_order)
       : n{g.num_vertices()},
         nodes(n),
-        mat(n * n) {
+        mat(static_cast<std::size_t>(n)*n) {
     for (index_type u=0; u<n; ++u) {
       for (auto v : g.adjacent_vertices(u)) {
         nodes[u].out.push_back(v);
@@ -2,6 +2,7 @@
 #define ORDERED_ADJACENCY_MATRIX_H_
 
 // TODO
+#include <cstddef>
 #include <vector>
 
 #include "graph_traits.h"
@@ -19,11 +20,11 @@ class ordered_adjacency_matrix {
   std::vector<index_type> indeg;
   
   void set(index_type i, index_type j) {
-    mat[i*n + j] = true;
+    mat[static_cast<std::size_t>(i)*n + j] = true;
   }
   
   bool get(index_type i, index_type j) const {
-    return mat[i*n + j];
+    return mat[static_cast<std::size_t>(i)*n + j];
   }
   
  public:
@@ -34,7 +35,7 @@ class ordered_adjacency_matrix {
       G_ const & g_,
       IndexOrder const & index_order)
       : n{g_.size()},
-        mat(n * n),
+        mat(static_cast<std::size_t>(n)*n),
         outdeg(n),
         indeg(n) {
     std::vector<index_type> index_pos(n);
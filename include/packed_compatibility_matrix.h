@@ -1,6 +1,9 @@
 #ifndef PACKED_COMPATIBILITY_MATRIX_H_
 #define PACKED_COMPATIBILITY_MATRIX_H_
 
+#include <cstddef>
+#include <iterator>
+#include <algorithm>
 #include <vector>
 
 template <
@@ -13,7 +16,7 @@ class packed_compatibility_matrix {
   IndexG const m;
   IndexH const n;
   
-  decltype((m*n+sizeof(bin_type))/sizeof(bin_type)) const frame_size;
+  decltype((static_cast<std::size_t>(m)*n+sizeof(bin_type))/sizeof(bin_type)) const frame_size;
 
   IndexG l;
   std::vector<bin_type> data;
@@ -21,21 +24,34 @@ class packed_compatibility_matrix {
   packed_compatibility_matrix(IndexG m, IndexH n)
       : m{m},
         n{n},
-        frame_size{(m*n+sizeof(bin_type))/sizeof(bin_type)},
+        frame_size{(static_cast<std::size_t>(m)*n+sizeof(bin_type))/sizeof(bin_type)},
         l{0},
         data((m+1)*frame_size) {
   }
+  
+  // a copy holds only the current frame and cannot revert past it
+  packed_compatibility_matrix(packed_compatibility_matrix const & other)
+      : m{other.m},
+        n{other.n},
+        frame_size{other.frame_size},
+        l{other.l},
+        data((m+1)*frame_size) {
+    std::copy_n(
+        std::next(std::begin(other.data), l*frame_size),
+        frame_size,
+        std::next(std::begin(data), l*frame_size));
+  }
 
   bool get(IndexG i, IndexH j) const {
-    auto idx = i*n + j;
+    auto idx = static_cast<std::size_t>(i)*n + j;
     return static_cast<bool>(data[l*frame_size + (idx / sizeof(bin_type))] & (static_cast<bin_type>(1) << (idx % sizeof(bin_type))));
   }
   void set(IndexG i, IndexH j) {
-    auto idx = i*n + j;
+    auto idx = static_cast<std::size_t>(i)*n + j;
     data[l*frame_size + (idx / sizeof(bin_type))] |= static_cast<bin_type>(1) << (idx % sizeof(bin_type));
   }
   void unset(IndexG i, IndexH j) {
-    auto idx = i*n + j;
+    auto idx = static_cast<std::size_t>(i)*n + j;
     data[l*frame_size + (idx / sizeof(bin_type))] &= ~(static_cast<bin_type>(1) << (idx % sizeof(bin_type)));
   }
 
@@ -0,0 +1,299 @@
+#ifndef PARALLEL_EXPLORE_H_
+#define PARALLEL_EXPLORE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "work_stealing_queue.h"
+#include "explore.h"
+#include "search_limits.h"
+#include "search_statistics.h"
+
+template <typename State>
+class parallel_explore_context {
+ public:
+  using candidate_type = std::decay_t<decltype(*std::begin(std::declval<State &>().candidates()))>;
+
+  // a fork of a prepared node together with the candidates left to try there
+  struct task {
+    std::unique_ptr<State> S;
+    std::vector<candidate_type> candidates;
+    std::size_t depth;
+  };
+
+  std::vector<work_stealing_queue<task>> queues;
+
+  std::atomic<std::size_t> pending;
+  // tasks in the queues, not yet acquired
+  std::atomic<std::size_t> queued;
+  std::atomic<unsigned> idle;
+  std::atomic<bool> stop;
+
+  // idle workers park here until there is work, the search is done or it
+  // is stopped
+  std::mutex mutex;
+  std::condition_variable wakeup;
+
+  explicit parallel_explore_context(unsigned num_threads)
+      : queues(num_threads),
+        pending{0},
+        queued{0},
+        idle{0},
+        stop{false} {
+  }
+
+  // taking the mutex orders the notification after a waiter's check
+  void notify(bool all) {
+    {
+      std::lock_guard<std::mutex> lock{mutex};
+    }
+    if (all) {
+      wakeup.notify_all();
+    } else {
+      wakeup.notify_one();
+    }
+  }
+
+  void halt() {
+    stop.store(true);
+    notify(true);
+  }
+
+  void finish() {
+    if (pending.fetch_sub(1) == 1) {
+      notify(true);
+    }
+  }
+
+  // the caller must already be counted in idle
+  void wait() {
+    std::unique_lock<std::mutex> lock{mutex};
+    wakeup.wait(lock, [this] {
+      return stop.load() || pending.load() == 0 || queued.load() > 0;
+    });
+  }
+
+  unsigned num_threads() const {
+    return queues.size();
+  }
+
+  void submit(unsigned id, task t) {
+    pending.fetch_add(1);
+    queues[id].push(std::move(t));
+    queued.fetch_add(1);
+    if (idle.load() > 0) {
+      notify(false);
+    }
+  }
+
+  bool acquire(unsigned id, task & t) {
+    if (queues[id].pop(t)) {
+      queued.fetch_sub(1);
+      return true;
+    }
+    for (unsigned k=1; k<num_threads(); ++k) {
+      if (queues[(id + k) % num_threads()].steal(t)) {
+        queued.fetch_sub(1);
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+template <
+    typename Statistics,
+    typename State,
+    typename Callback>
+class parallel_explorer {
+ private:
+  using context_type = parallel_explore_context<State>;
+  using task = typename context_type::task;
+  using candidate_type = typename context_type::candidate_type;
+
+  Callback & callback;
+  Statistics & statistics;
+  limit_checker checker;
+
+  context_type & context;
+  unsigned id;
+
+  bool split_wanted() const {
+    return context.idle.load(std::memory_order_relaxed) > 0 && context.queues[id].empty();
+  }
+
+  template <typename Candidates>
+  bool explore_candidates(State & S, Candidates && candidates, std::size_t depth) {
+    bool proceed = true;
+    auto last = std::end(candidates);
+    for (auto it=std::begin(candidates); it!=last; ++it) {
+      candidate_type y = *it;
+      bool split = std::next(it) != last && split_wanted();
+      if (split) {
+        task t{std::unique_ptr<State>{new State(S.fork())}, {}, depth};
+        for (auto rest=std::next(it); rest!=last; ++rest) {
+          t.candidates.push_back(*rest);
+        }
+        context.submit(id, std::move(t));
+      }
+      statistics.candidate();
+      S.advance();
+      bool success = statistics.template timed<search_phase::assign>([&S, &y] {return S.assign(y);});
+      if (success) {
+        statistics.template timed<search_phase::push>([&S, &y] {S.push(y);});
+        statistics.push();
+        proceed = explore(S, depth+1);
+        statistics.template timed<search_phase::pop>([&S] {S.pop();});
+      } else {
+        statistics.assign_failure();
+      }
+      S.revert();
+      if (!proceed || split) {
+        break;
+      }
+    }
+    return proceed;
+  }
+
+  bool explore(State & S, std::size_t depth) {
+    if (context.stop.load(std::memory_order_relaxed)) {
+      return false;
+    }
+    if (!checker.node()) {
+      context.halt();
+      return false;
+    }
+    statistics.node(depth);
+    if (S.full()) {
+      if (!checker.solution()) {
+        context.halt();
+        return false;
+      }
+      statistics.solution();
+      if (!callback(S.embedding()) || checker.stopped()) {
+        context.halt();
+        return false;
+      }
+      return true;
+    } else {
+      statistics.template timed<search_phase::prepare>([&S] {S.prepare();});
+      bool proceed = explore_candidates(S, S.candidates(), depth);
+      S.forget();
+      return proceed;
+    }
+  }
+
+ public:
+  parallel_explorer(
+      Callback & callback,
+      Statistics & statistics,
+      search_limits * limits,
+      context_type & context,
+      unsigned id)
+      : callback{callback},
+        statistics{statistics},
+        checker{limits},
+        context{context},
+        id{id} {
+  }
+
+  void run(State * root) {
+    if (root != nullptr) {
+      explore(*root, 0);
+      context.finish();
+    }
+    task t;
+    bool idle = false;
+    while (!context.stop.load(std::memory_order_relaxed)) {
+      if (context.acquire(id, t)) {
+        if (idle) {
+          context.idle.fetch_sub(1);
+          idle = false;
+        }
+        explore_candidates(*t.S, t.candidates, t.depth);
+        t.S.reset();
+        context.finish();
+      } else if (context.pending.load() == 0) {
+        break;
+      } else {
+        if (!idle) {
+          checker.release();
+          context.idle.fetch_add(1);
+          idle = true;
+        }
+        context.wait();
+      }
+    }
+    if (idle) {
+      context.idle.fetch_sub(1);
+    }
+  }
+};
+
+// S is explored from the calling state; idle workers receive forks of the
+// nodes still being expanded. Every worker uses its own copy of callback,
+// which is therefore called concurrently, and its own Statistics; the
+// reports are summed once all workers are done. limits, if given, bound
+// the search as a whole.
+template <
+    typename Statistics = no_statistics,
+    typename State,
+    typename Callback>
+search_statistics parallel_explore(State & S, Callback callback, unsigned num_threads, search_limits * limits = nullptr) {
+  if (num_threads <= 1) {
+    return explore<Statistics>(S, callback, limits);
+  }
+
+  parallel_explore_context<State> context{num_threads};
+  context.pending.store(1);
+
+  std::vector<Statistics> statistics(num_threads);
+  std::vector<std::thread> workers;
+  for (unsigned id=0; id<num_threads; ++id) {
+    workers.emplace_back([&S, &callback, &statistics, limits, &context, id]() {
+      Callback worker_callback{callback};
+      parallel_explorer<Statistics, State, Callback> e{worker_callback, statistics[id], limits, context, id};
+      e.run(id == 0 ? &S : nullptr);
+    });
+  }
+  for (auto & worker : workers) {
+    worker.join();
+  }
+
+  search_statistics report;
+  for (auto const & s : statistics) {
+    report += s.report();
+  }
+  report.limit = limits != nullptr ? limits->hit() : search_limit::none;
+  return report;
+}
+
+// Passed as the callback of a predefined.h function, hands its prepared
+// state to f instead of exploring it, e.g. to drive an explore_cursor.
+template <typename F>
+struct state_visitor {
+  F f;
+};
+
+template <typename F>
+state_visitor<F> visit_state(F f) {
+  return {std::move(f)};
+}
+
+template <
+    typename Statistics = no_statistics,
+    typename State,
+    typename F>
+search_statistics parallel_explore(State & S, state_visitor<F> visitor, unsigned, search_limits * = nullptr) {
+  visitor.f(S);
+  return {};
+}
+
+#endif  // PARALLEL_EXPLORE_H_
@@ -1,6 +1,7 @@
 #ifndef PARENT_STATE_H_
 #define PARENT_STATE_H_
 
+#include <cstddef>
 #include <iterator>
 #include <vector>
 #include <functional>
@@ -65,8 +66,8 @@ class parent_state_mono {
         n{h.num_vertices()},
         g{g},
         h{h},
-        compatibility(m*n),
-        compatibility_stack(m*n),
+        compatibility(static_cast<std::size_t>(m)*n),
+        compatibility_stack(static_cast<std::size_t>(m)*n),
         initial_cands_vec(m),
         initial_cands(m),
         cands(m),
@@ -78,7 +79,7 @@ class parent_state_mono {
         if (vertex_comp(i, j) &&
             g.out_degree(i) <= h.out_degree(j) &&
             g.in_degree(i) <= h.in_degree(j)) {
-          auto idx = i*n + j;
+          auto idx = static_cast<std::size_t>(i)*n + j;
           compatibility[idx] = true;
           initial_cands_vec[i].push_back(j);
         }
@@ -91,7 +92,40 @@ class parent_state_mono {
     g_heap.heapify();
   }
   
-  parent_state_mono(parent_state_mono const &) = delete;
+ protected:
+  // cands point into initial_cands_vec and g_heap compares by score, so both
+  // have to be rebound to the copies
+  parent_state_mono(parent_state_mono const & other)
+      : m{other.m},
+        n{other.n},
+        g{other.g},
+        h{other.h},
+        vertex_comp{other.vertex_comp},
+        edge_comp{other.edge_comp},
+        compatibility(other.compatibility),
+        compatibility_stack(other.compatibility_stack),
+        initial_cands_vec(other.initial_cands_vec),
+        initial_cands(m),
+        cands(m),
+        parent_stack(other.parent_stack),
+        score(other.score),
+        g_heap(other.g_heap, compare(score)) {
+    for (IndexG i=0; i<m; ++i) {
+      auto first = std::cbegin(initial_cands_vec[i]);
+      auto other_first = std::cbegin(other.initial_cands_vec[i]);
+      initial_cands[i] = boost::make_iterator_range(
+          std::next(first, std::begin(other.initial_cands[i]) - other_first),
+          std::next(first, std::end(other.initial_cands[i]) - other_first));
+      cands[i] = boost::make_iterator_range(
+          std::next(first, std::begin(other.cands[i]) - other_first),
+          std::next(first, std::end(other.cands[i]) - other_first));
+    }
+  }
+  
+ public:
+  parent_state_mono fork() const {
+    return parent_state_mono{*this};
+  }
 
   bool empty() {
     return g_heap.full();
@@ -124,7 +158,7 @@ class parent_state_mono {
 
   bool assign(IndexH y) {
     auto x = g_heap.top();
-    return compatibility[x*n+y];
+    return compatibility[static_cast<std::size_t>(x)*n+y];
   }
 
   void push(IndexH y) {
@@ -142,7 +176,7 @@ class parent_state_mono {
       IndexH j;
       std::tie(i, j) = compatibility_stack.top();
       compatibility_stack.pop();
-      compatibility[i*n+j] = true;
+      compatibility[static_cast<std::size_t>(i)*n+j] = true;
       ++score[i];
     }
     while(!parent_stack.level_empty()) {
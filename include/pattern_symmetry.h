@@ -0,0 +1,302 @@
+#ifndef PATTERN_SYMMETRY_H_
+#define PATTERN_SYMMETRY_H_
+
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "adjacency_listmat.h"
+#include "vertex_order.h"
+#include "predefined.h"
+#include "parallel_explore.h"
+#include "search_limits.h"
+#include "search_statistics.h"
+#include "solution_counter.h"
+
+// Symmetry-breaking constraints map[a] < map[b] of a pattern: of the
+// embeddings that differ only by an automorphism of the pattern, exactly
+// one satisfies all of them.
+template <typename IndexG>
+class symmetry_breaking {
+ public:
+  struct constraint {
+    IndexG other;
+    // map[x] < map[other] if true, map[x] > map[other] otherwise
+    bool less;
+  };
+
+ private:
+  std::vector<std::pair<IndexG, IndexG>> pairs;
+  std::vector<std::vector<constraint>> by_vertex;
+  std::vector<IndexG> orbit_sizes;
+
+ public:
+  explicit symmetry_breaking(IndexG m = 0)
+      : by_vertex(m) {
+  }
+
+  void add(IndexG a, IndexG b) {
+    pairs.emplace_back(a, b);
+    by_vertex[a].push_back({b, true});
+    by_vertex[b].push_back({a, false});
+  }
+
+  void add_orbit(IndexG size) {
+    orbit_sizes.push_back(size);
+  }
+
+  std::vector<std::pair<IndexG, IndexG>> const & less() const {
+    return pairs;
+  }
+
+  std::vector<constraint> const & constraints(IndexG x) const {
+    return by_vertex[x];
+  }
+
+  bool trivial() const {
+    return pairs.empty();
+  }
+
+  // order of the automorphism group, the product of the orbit sizes met
+  // while building the constraints
+  template <typename Count = std::uint64_t>
+  Count automorphisms() const {
+    Count result = 1;
+    for (auto size : orbit_sizes) {
+      result *= size;
+    }
+    return result;
+  }
+
+  template <typename Embedding>
+  bool allows(Embedding const & e) const {
+    for (auto const & p : pairs) {
+      if (!(e[p.first] < e[p.second])) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+// Grochow-Kellis constraints of g. Walking index_order_g, the first vertex
+// v whose orbit under the automorphisms fixing the vertices seen so far is
+// not trivial gets map[v] < map[u] for every other u of that orbit. Since
+// v comes early in the order the search uses, the constraints prune near
+// the root. Orbits are found by searching g for automorphisms with the
+// fixed vertices pinned; vertex_same(i, j) and edge_same(i0, i1, j0, j1)
+// say which pattern vertices and arcs an automorphism may exchange. They
+// must be at least as fine as vertex_comp and edge_comp of the search:
+// two pattern vertices (arcs) may only be declared the same if every
+// target vertex (arc) compatible with one is compatible with the other,
+// or the constraints cut off embeddings that have no symmetric twin.
+template <
+    typename G,
+    typename IndexOrderG,
+    typename VertexSame,
+    typename EdgeSame>
+symmetry_breaking<typename G::index_type> pattern_symmetry(
+    G const & g,
+    IndexOrderG const & index_order_g,
+    VertexSame vertex_same,
+    EdgeSame edge_same) {
+  using IndexG = typename G::index_type;
+  IndexG m = g.num_vertices();
+  symmetry_breaking<IndexG> symmetry{m};
+
+  std::vector<char> fixed(m);
+  auto exchangeable = [&](IndexG v, IndexG u) {
+    bool found = false;
+    auto pinned = [&](auto i, auto j) {
+      if (fixed[i]) {
+        return static_cast<IndexG>(j) == i;
+      }
+      if (i == v) {
+        return static_cast<IndexG>(j) == u;
+      }
+      return vertex_same(i, j);
+    };
+    ri_ind(g, g, [&found](auto const &) {
+      found = true;
+      return false;
+    }, pinned, edge_same);
+    return found;
+  };
+
+  for (auto v : index_order_g) {
+    std::vector<IndexG> orbit;
+    for (IndexG u=0; u<m; ++u) {
+      if (u != v && !fixed[u] && exchangeable(v, u)) {
+        orbit.push_back(u);
+      }
+    }
+    if (!orbit.empty()) {
+      for (auto u : orbit) {
+        symmetry.add(v, u);
+      }
+      symmetry.add_orbit(orbit.size() + 1);
+    }
+    fixed[v] = true;
+  }
+  return symmetry;
+}
+
+// every automorphism of the bare graph; only valid for unlabelled
+// matching, where vertex_comp and edge_comp accept everything
+template <
+    typename G,
+    typename IndexOrderG>
+symmetry_breaking<typename G::index_type> pattern_symmetry(G const & g, IndexOrderG const & index_order_g) {
+  return pattern_symmetry(
+      g,
+      index_order_g,
+      [](auto, auto) {return true;},
+      [](auto, auto, auto, auto) {return true;});
+}
+
+// ordered like the greatest-constraint-first searches of predefined.h;
+// like the overload above, only valid for unlabelled matching
+template <typename G>
+symmetry_breaking<typename G::index_type> pattern_symmetry(G const & g) {
+  adjacency_listmat<typename G::index_type> g_listmat{g};
+  return pattern_symmetry(g, vertex_order_GreatestConstraintFirst(g_listmat));
+}
+
+// Runs State under the constraints of symmetry: assign() also rejects a
+// target vertex that would break one of them against an already mapped
+// vertex. Any state with current() and embedding() can be wrapped.
+template <
+    typename State,
+    typename IndexG>
+class symmetry_breaking_state {
+ private:
+  std::unique_ptr<State> owned;
+  State & S;
+  symmetry_breaking<IndexG> const & symmetry;
+
+  symmetry_breaking_state(std::unique_ptr<State> owned, symmetry_breaking<IndexG> const & symmetry)
+      : owned{std::move(owned)},
+        S{*this->owned},
+        symmetry{symmetry} {
+  }
+
+ public:
+  symmetry_breaking_state(State & S, symmetry_breaking<IndexG> const & symmetry)
+      : S{S},
+        symmetry{symmetry} {
+  }
+
+  symmetry_breaking_state fork() const {
+    return symmetry_breaking_state{std::unique_ptr<State>{new State(S.fork())}, symmetry};
+  }
+
+  auto embedding() const {
+    return S.embedding();
+  }
+
+  IndexG current() const {
+    return S.current();
+  }
+
+  bool full() {
+    return S.full();
+  }
+
+  void prepare() {
+    S.prepare();
+  }
+
+  void forget() {
+    S.forget();
+  }
+
+  decltype(auto) candidates() {
+    return S.candidates();
+  }
+
+  void advance() {
+    S.advance();
+  }
+
+  void revert() {
+    S.revert();
+  }
+
+  template <typename IndexH>
+  bool assign(IndexH y) {
+    auto e = S.embedding();
+    for (auto const & c : symmetry.constraints(S.current())) {
+      auto z = e[c.other];
+      if (z != e.target_size() && (c.less ? !(y < z) : !(z < y))) {
+        return false;
+      }
+    }
+    return S.assign(y);
+  }
+
+  template <typename IndexH>
+  void push(IndexH y) {
+    S.push(y);
+  }
+
+  void pop() {
+    S.pop();
+  }
+};
+
+// Like algorithm(g, h, callback, vertex_comp, edge_comp, limits), e.g.
+// PORTFOLIO_ALGORITHM(ri_ind), but callback only gets the embeddings that
+// satisfy symmetry, one per occurrence of g in h.
+template <
+    typename Statistics = no_statistics,
+    typename G,
+    typename H,
+    typename Algorithm,
+    typename Callback,
+    typename VertexEquivalencePredicate,
+    typename EdgeEquivalencePredicate>
+search_statistics explore_unique(
+    G const & g,
+    H const & h,
+    Algorithm algorithm,
+    symmetry_breaking<typename G::index_type> const & symmetry,
+    Callback callback,
+    VertexEquivalencePredicate vertex_comp,
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
+  search_statistics report;
+  algorithm(g, h, visit_state([&](auto & S) {
+    using State = std::remove_reference_t<decltype(S)>;
+    symmetry_breaking_state<State, typename G::index_type> W{S, symmetry};
+    report = parallel_explore<Statistics>(W, callback, num_threads, limits);
+  }), vertex_comp, edge_comp, limits);
+  return report;
+}
+
+// Number of embeddings, counted as occurrences times automorphisms.
+template <
+    typename Count = std::uint64_t,
+    typename G,
+    typename H,
+    typename Algorithm,
+    typename VertexEquivalencePredicate,
+    typename EdgeEquivalencePredicate>
+Count count_by_symmetry(
+    G const & g,
+    H const & h,
+    Algorithm algorithm,
+    symmetry_breaking<typename G::index_type> const & symmetry,
+    VertexEquivalencePredicate vertex_comp,
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
+  std::atomic<std::uint64_t> occurrences{0};
+  explore_unique(g, h, algorithm, symmetry, solution_counter<>{occurrences}, vertex_comp, edge_comp, num_threads, limits);
+  return static_cast<Count>(occurrences.load()) * symmetry.template automorphisms<Count>();
+}
+
+#endif  // PATTERN_SYMMETRY_H_
@@ -0,0 +1,202 @@
+#ifndef PORTFOLIO_H_
+#define PORTFOLIO_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "search_limits.h"
+
+// Races several predefined.h algorithms on the same read-only g and h, one
+// thread each. The first run to deliver a solution, or to finish without
+// one, owns the race: only its solutions reach the callback, which is
+// therefore never called concurrently, and every other run is cancelled
+// through its search_limits. A cancelled run stops at its next node, or,
+// if it is still building its initial domain, after the current pattern
+// vertex, so the race returns soon after the winner is done rather than
+// after the slowest preprocessing.
+//
+// Algorithms are passed as PORTFOLIO_ALGORITHM(ullimp4_ind), ...
+
+struct portfolio_result {
+  // position of the winning algorithm in the argument list
+  std::size_t winner;
+  // solutions passed to the callback
+  std::uint64_t solutions;
+  // the winner searched its whole tree
+  bool exhausted;
+};
+
+class portfolio_race {
+ public:
+  static constexpr unsigned none = std::numeric_limits<unsigned>::max();
+
+ private:
+  std::atomic<unsigned> owner{none};
+  std::unique_ptr<search_limits[]> limits;
+  unsigned size;
+
+ public:
+  // losers should stop promptly even where single nodes are expensive,
+  // and the counters checked are not shared with other runs
+  explicit portfolio_race(unsigned size)
+      : limits{new search_limits[size]},
+        size{size} {
+    for (unsigned id=0; id<size; ++id) {
+      limits[id].check_interval = 1;
+    }
+  }
+
+  search_limits & limits_of(unsigned id) {
+    return limits[id];
+  }
+
+  // true if id owns the race, possibly just now
+  bool claim(unsigned id) {
+    unsigned expected = none;
+    if (owner.compare_exchange_strong(expected, id)) {
+      for (unsigned other=0; other<size; ++other) {
+        if (other != id) {
+          limits[other].cancel.store(true);
+        }
+      }
+      return true;
+    }
+    return expected == id;
+  }
+
+  unsigned winner() const {
+    return owner.load();
+  }
+};
+
+#define PORTFOLIO_ALGORITHM(f) \
+  [](auto const & g, auto const & h, auto callback, auto vertex_comp, auto edge_comp, search_limits * limits) { \
+    return f(g, h, callback, vertex_comp, edge_comp, 1, limits); \
+  }
+
+// Runs run(i, algorithm_i) for every algorithm on its own thread.
+template <
+    typename Run,
+    typename... Algorithms,
+    std::size_t... I>
+void portfolio_launch(
+    Run & run,
+    std::index_sequence<I...>,
+    Algorithms & ... algorithms) {
+  std::vector<std::thread> threads;
+  (threads.emplace_back([&run, &algorithms]() {run(I, algorithms);}), ...);
+  for (auto & thread : threads) {
+    thread.join();
+  }
+}
+
+// Decision (k = 1) and first-k queries: the winner passes at most k
+// solutions to callback, fewer only if there are no more.
+template <
+    typename G,
+    typename H,
+    typename Callback,
+    typename VertexEquivalencePredicate,
+    typename EdgeEquivalencePredicate,
+    typename... Algorithms>
+portfolio_result portfolio_first(
+    G const & g,
+    H const & h,
+    Callback callback,
+    VertexEquivalencePredicate vertex_comp,
+    EdgeEquivalencePredicate edge_comp,
+    std::uint64_t k,
+    Algorithms... algorithms) {
+  portfolio_race race{sizeof...(Algorithms)};
+  std::uint64_t solutions = 0;
+  bool stopped = false;
+
+  auto run = [&](unsigned id, auto & algorithm) {
+    auto owned_callback = [&race, &callback, &solutions, &stopped, k, id](auto const & S) {
+      if (!race.claim(id)) {
+        return false;
+      }
+      ++solutions;
+      stopped = !callback(S) || solutions >= k;
+      return !stopped;
+    };
+    auto & limits = race.limits_of(id);
+    if (k > 0) {
+      algorithm(g, h, owned_callback, vertex_comp, edge_comp, &limits);
+    }
+    if (limits.hit() == search_limit::none) {
+      race.claim(id);
+    }
+  };
+  portfolio_launch(run, std::index_sequence_for<Algorithms...>{}, algorithms...);
+
+  return {race.winner(), solutions, !stopped};
+}
+
+// Full enumeration: every algorithm is probed for at most probe, only
+// counting solutions. One that finishes within the probe wins outright,
+// otherwise the one with most solutions so far, the earlier one on ties.
+// The winner then enumerates from scratch on the calling thread.
+template <
+    typename G,
+    typename H,
+    typename Callback,
+    typename VertexEquivalencePredicate,
+    typename EdgeEquivalencePredicate,
+    typename... Algorithms>
+portfolio_result portfolio_enumerate(
+    G const & g,
+    H const & h,
+    Callback callback,
+    VertexEquivalencePredicate vertex_comp,
+    EdgeEquivalencePredicate edge_comp,
+    std::chrono::steady_clock::duration probe,
+    Algorithms... algorithms) {
+  portfolio_race race{sizeof...(Algorithms)};
+  std::vector<std::uint64_t> probe_solutions(sizeof...(Algorithms));
+
+  auto probe_run = [&](unsigned id, auto & algorithm) {
+    auto count = [&probe_solutions, id](auto const &) {
+      ++probe_solutions[id];
+      return true;
+    };
+    auto & limits = race.limits_of(id);
+    limits.within(probe);
+    algorithm(g, h, count, vertex_comp, edge_comp, &limits);
+    if (limits.hit() == search_limit::none) {
+      race.claim(id);
+    }
+  };
+  portfolio_launch(probe_run, std::index_sequence_for<Algorithms...>{}, algorithms...);
+
+  std::size_t winner = race.winner();
+  if (winner >= sizeof...(Algorithms)) {
+    winner = 0;
+    for (std::size_t i=1; i<probe_solutions.size(); ++i) {
+      if (probe_solutions[i] > probe_solutions[winner]) {
+        winner = i;
+      }
+    }
+  }
+
+  std::uint64_t solutions = 0;
+  bool stopped = false;
+  auto counted_callback = [&callback, &solutions, &stopped](auto const & S) {
+    ++solutions;
+    stopped = !callback(S);
+    return !stopped;
+  };
+  std::size_t i = 0;
+  ((i++ == winner ? void(algorithms(g, h, counted_callback, vertex_comp, edge_comp, nullptr)) : void()), ...);
+
+  return {winner, solutions, !stopped};
+}
+
+#endif  // PORTFOLIO_H_
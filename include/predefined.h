@@ -4,16 +4,22 @@
 #include "adjacency_set.h"
 #include "adjacency_matrix.h"
 #include "adjacency_list.h"
+#include "csr_adjacency_list.h"
+#include "csr_adjacency_listmat.h"
+#include "csr_adjacency_listmat_with_not.h"
 #include "adjacency_list_in_order.h"
 #include "ordered_adjacency_list.h"
 #include "ordered_adjacency_list_with_not_after.h"
 #include "adjacency_listmat.h"
 #include "adjacency_listmat_with_not.h"
+#include "sparse_adjacency_listmat.h"
 #include "ordered_adjacency_listmat.h"
 #include "ordered_adjacency_listmat_with_not_after.h"
 #include "orderable_adjacency_listmat.h"
 #include "orderable_adjacency_listmat_with_ri_degree.h"
 #include "pushable_adjacency_listmat.h"
+#include "prepared_target.h"
+#include "initial_domain.h"
 
 #include "ullmann_state.h"
 #include "ullmann_oalwna_state.h"
@@ -23,6 +29,7 @@
 #include "ullimp2_state.h"
 #include "ullimp3_state.h"
 #include "ullimp4_state.h"
+#include "ullimp_bit_state.h"
 #include "simple_state.h"
 #include "ri_state.h"
 #include "ri2_state.h"
@@ -45,959 +52,1491 @@
 #include "reduced_compatibility_matrix.h"
 #include "reduced_compatibility_matrix2.h"
 #include "reduced_compatibility_matrix2_with_count.h"
+#include "trail_compatibility_matrix.h"
 #include "reduced_compatibility_linked_matrix.h"
+#include "word_compatibility_matrix.h"
+
+#include "refinement.h"
+#include "alldifferent.h"
 
 #include "vertex_order.h"
 #include "explore.h"
+#include "parallel_explore.h"
+#include "search_limits.h"
+#include "search_statistics.h"
 
 template <
+    typename Statistics = no_statistics,
     typename G_,
     typename H_,
     typename Callback,
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate>
-void ullmann_mono(
+search_statistics ullmann_mono(
     G_ const & g_,
     H_ const & h_,
     Callback callback,
     VertexEquivalencePredicate vertex_comp,
-    EdgeEquivalencePredicate edge_comp) {
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
   adjacency_matrix<typename G_::index_type> g{g_};
-  adjacency_matrix<typename H_::index_type> h{h_};
+  using H = adjacency_matrix<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
+  
+  auto index_order_g = vertex_order_DEG(g);
+  
+  ullmann_state_mono<
+      decltype(g),
+      H,
+      typename decltype(domain)::predicate_type,
+      EdgeEquivalencePredicate,
+      trail_compatibility_matrix<typename decltype(g)::index_type, typename H::index_type>,
+      decltype(index_order_g),
+      sweep_refinement<typename decltype(g)::index_type, typename H::index_type>> S{g, h, domain.predicate(), edge_comp, index_order_g};
+  
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
+}
+
+template <
+    typename Statistics = no_statistics,
+    typename G_,
+    typename H_,
+    typename Callback,
+    typename VertexEquivalencePredicate,
+    typename EdgeEquivalencePredicate>
+search_statistics ullmann_worklist_mono(
+    G_ const & g_,
+    H_ const & h_,
+    Callback callback,
+    VertexEquivalencePredicate vertex_comp,
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
+  adjacency_listmat<typename G_::index_type> g{g_};
+  using H = adjacency_listmat<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
   
   auto index_order_g = vertex_order_DEG(g);
   
   ullmann_state_mono<
       decltype(g),
-      decltype(h),
-      VertexEquivalencePredicate,
+      H,
+      typename decltype(domain)::predicate_type,
       EdgeEquivalencePredicate,
-      compatibility_matrix<typename decltype(g)::index_type, typename decltype(h)::index_type>,
-      decltype(index_order_g)> S{g, h, vertex_comp, edge_comp, index_order_g};
+      trail_compatibility_matrix<typename decltype(g)::index_type, typename H::index_type>,
+      decltype(index_order_g),
+      worklist_refinement<typename decltype(g)::index_type, typename H::index_type>> S{g, h, domain.predicate(), edge_comp, index_order_g};
   
-  explore(S, callback);
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
 }
 
 template <
+    typename Statistics = no_statistics,
     typename G_,
     typename H_,
     typename Callback,
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate>
-void ullmann_ind(
+search_statistics ullmann_ind(
     G_ const & g_,
     H_ const & h_,
     Callback callback,
     VertexEquivalencePredicate vertex_comp,
-    EdgeEquivalencePredicate edge_comp) {
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
   adjacency_matrix<typename G_::index_type> g{g_};
-  adjacency_matrix<typename H_::index_type> h{h_};
+  using H = adjacency_matrix<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
+  
+  auto index_order_g = vertex_order_DEG(g);
+  
+  ullmann_state_ind<
+      decltype(g),
+      H,
+      typename decltype(domain)::predicate_type,
+      EdgeEquivalencePredicate,
+      trail_compatibility_matrix<typename decltype(g)::index_type, typename H::index_type>,
+      decltype(index_order_g),
+      sweep_refinement<typename decltype(g)::index_type, typename H::index_type>> S{g, h, domain.predicate(), edge_comp, index_order_g};
+  
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
+}
+
+template <
+    typename Statistics = no_statistics,
+    typename G_,
+    typename H_,
+    typename Callback,
+    typename VertexEquivalencePredicate,
+    typename EdgeEquivalencePredicate>
+search_statistics ullmann_worklist_ind(
+    G_ const & g_,
+    H_ const & h_,
+    Callback callback,
+    VertexEquivalencePredicate vertex_comp,
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
+  adjacency_listmat<typename G_::index_type> g{g_};
+  using H = adjacency_listmat_with_not<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
   
   auto index_order_g = vertex_order_DEG(g);
   
   ullmann_state_ind<
       decltype(g),
-      decltype(h),
-      VertexEquivalencePredicate,
+      H,
+      typename decltype(domain)::predicate_type,
       EdgeEquivalencePredicate,
-      compatibility_matrix<typename decltype(g)::index_type, typename decltype(h)::index_type>,
-      decltype(index_order_g)> S{g, h, vertex_comp, edge_comp, index_order_g};
+      trail_compatibility_matrix<typename decltype(g)::index_type, typename H::index_type>,
+      decltype(index_order_g),
+      worklist_refinement<typename decltype(g)::index_type, typename H::index_type>> S{g, h, domain.predicate(), edge_comp, index_order_g};
   
-  explore(S, callback);
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
 }
 
 template <
+    typename Statistics = no_statistics,
     typename G_,
     typename H_,
     typename Callback,
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate>
-void ullmann_mono_RDEG_CNC(
+search_statistics ullmann_mono_RDEG_CNC(
     G_ const & g_,
     H_ const & h_,
     Callback callback,
     VertexEquivalencePredicate vertex_comp,
-    EdgeEquivalencePredicate edge_comp) {
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
   
   adjacency_listmat<typename G_::index_type> gas{g_};
   auto index_order_g = vertex_order_RDEG_CNC(gas);
   
   adjacency_matrix<typename G_::index_type> g{g_};
-  adjacency_matrix<typename H_::index_type> h{h_};
+  using H = adjacency_matrix<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
   
   ullmann_state_mono<
       decltype(g),
-      decltype(h),
-      VertexEquivalencePredicate,
+      H,
+      typename decltype(domain)::predicate_type,
       EdgeEquivalencePredicate,
-      compatibility_matrix<typename decltype(g)::index_type, typename decltype(h)::index_type>,
-      decltype(index_order_g)> S{g, h, vertex_comp, edge_comp, index_order_g};
+      trail_compatibility_matrix<typename decltype(g)::index_type, typename H::index_type>,
+      decltype(index_order_g),
+      sweep_refinement<typename decltype(g)::index_type, typename H::index_type>> S{g, h, domain.predicate(), edge_comp, index_order_g};
   
-  explore(S, callback);
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
 }
 
 template <
+    typename Statistics = no_statistics,
     typename G_,
     typename H_,
     typename Callback,
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate>
-void ullmann_ind_RDEG_CNC(
+search_statistics ullmann_ind_RDEG_CNC(
     G_ const & g_,
     H_ const & h_,
     Callback callback,
     VertexEquivalencePredicate vertex_comp,
-    EdgeEquivalencePredicate edge_comp) {
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
   
   adjacency_listmat<typename G_::index_type> gas{g_};
   auto index_order_g = vertex_order_RDEG_CNC(gas);
   
   adjacency_matrix<typename G_::index_type> g{g_};
-  adjacency_matrix<typename H_::index_type> h{h_};
+  using H = adjacency_matrix<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
   
   ullmann_state_ind<
       decltype(g),
-      decltype(h),
-      VertexEquivalencePredicate,
+      H,
+      typename decltype(domain)::predicate_type,
       EdgeEquivalencePredicate,
-      compatibility_matrix<typename decltype(g)::index_type, typename decltype(h)::index_type>,
-      decltype(index_order_g)> S{g, h, vertex_comp, edge_comp, index_order_g};
+      trail_compatibility_matrix<typename decltype(g)::index_type, typename H::index_type>,
+      decltype(index_order_g),
+      sweep_refinement<typename decltype(g)::index_type, typename H::index_type>> S{g, h, domain.predicate(), edge_comp, index_order_g};
   
-  explore(S, callback);
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
 }
 
 template <
+    typename Statistics = no_statistics,
     typename G_,
     typename H_,
     typename Callback,
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate>
-void ullmann_oalwna_mono(
+search_statistics ullmann_oalwna_mono(
     G_ const & g_,
     H_ const & h_,
     Callback callback,
     VertexEquivalencePredicate vertex_comp,
-    EdgeEquivalencePredicate edge_comp) {
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
   
   adjacency_listmat<typename G_::index_type> galm{g_};
   auto index_order_g = vertex_order_RDEG_CNC(galm);
   
   ordered_adjacency_list_with_not_after<typename G_::index_type> g(galm, index_order_g);
-  adjacency_listmat<typename H_::index_type> h{h_};
+  using H = adjacency_listmat<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
   
   ullmann_oalwna_state_mono<
       decltype(g),
-      decltype(h),
-      VertexEquivalencePredicate,
+      H,
+      typename decltype(domain)::predicate_type,
       EdgeEquivalencePredicate,
-      compatibility_matrix<typename decltype(g)::index_type, typename decltype(h)::index_type>,
-      decltype(index_order_g)> S{g, h, vertex_comp, edge_comp, index_order_g};
+      trail_compatibility_matrix<typename decltype(g)::index_type, typename H::index_type>,
+      decltype(index_order_g)> S{g, h, domain.predicate(), edge_comp, index_order_g};
   
-  explore(S, callback);
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
 }
 
 template <
+    typename Statistics = no_statistics,
     typename G_,
     typename H_,
     typename Callback,
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate>
-void neighborhood_filter_ind(
+search_statistics neighborhood_filter_ind(
     G_ const & g_,
     H_ const & h_,
     Callback callback,
     VertexEquivalencePredicate vertex_comp,
-    EdgeEquivalencePredicate edge_comp) {
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
   
   adjacency_listmat<typename G_::index_type> galm{g_};
   auto index_order_g = vertex_order_RDEG_CNC(galm);
   //auto index_order_g = vertex_order_GreatestConstraintFirst(galm);
   
   ordered_adjacency_listmat_with_not_after<typename G_::index_type> g(g_, index_order_g);
-  adjacency_listmat_with_not<typename H_::index_type> h{h_};
+  using H = adjacency_listmat_with_not<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
   
   neighborhood_filter_state_ind<
       decltype(g),
-      decltype(h),
-      VertexEquivalencePredicate,
+      H,
+      typename decltype(domain)::predicate_type,
+      EdgeEquivalencePredicate,
+      reduced_compatibility_matrix2<typename decltype(g)::index_type, typename H::index_type>,
+      decltype(index_order_g)> S{g, h, domain.predicate(), edge_comp, index_order_g};
+  
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
+}
+
+template <
+    typename Statistics = no_statistics,
+    typename G_,
+    typename H_,
+    typename Callback,
+    typename VertexEquivalencePredicate,
+    typename EdgeEquivalencePredicate>
+search_statistics ullimp_ind(
+    G_ const & g_,
+    H_ const & h_,
+    Callback callback,
+    VertexEquivalencePredicate vertex_comp,
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
+  
+  adjacency_listmat<typename G_::index_type> galm{g_};
+  //auto index_order_g = vertex_order_RDEG_CNC(galm);
+  auto index_order_g = vertex_order_GreatestConstraintFirst(galm);
+  
+  ordered_adjacency_listmat_with_not_after<typename G_::index_type> g{g_, index_order_g};
+  using H = csr_adjacency_listmat_with_not<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
+  
+  ullimp_state_ind<
+      decltype(g),
+      H,
+      typename decltype(domain)::predicate_type,
+      EdgeEquivalencePredicate,
+      reduced_compatibility_matrix2<typename decltype(g)::index_type, typename H::index_type>,
+      decltype(index_order_g),
+      sweep_refinement<typename decltype(g)::index_type, typename H::index_type, false>> S{g, h, domain.predicate(), edge_comp, index_order_g};
+  
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
+}
+
+template <
+    typename Statistics = no_statistics,
+    typename G_,
+    typename H_,
+    typename Callback,
+    typename VertexEquivalencePredicate,
+    typename EdgeEquivalencePredicate>
+search_statistics ullimp_worklist_ind(
+    G_ const & g_,
+    H_ const & h_,
+    Callback callback,
+    VertexEquivalencePredicate vertex_comp,
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
+  
+  adjacency_listmat<typename G_::index_type> galm{g_};
+  //auto index_order_g = vertex_order_RDEG_CNC(galm);
+  auto index_order_g = vertex_order_GreatestConstraintFirst(galm);
+  
+  ordered_adjacency_listmat_with_not_after<typename G_::index_type> g{g_, index_order_g};
+  using H = csr_adjacency_listmat_with_not<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
+  
+  ullimp_state_ind<
+      decltype(g),
+      H,
+      typename decltype(domain)::predicate_type,
       EdgeEquivalencePredicate,
-      reduced_compatibility_matrix2<typename decltype(g)::index_type, typename decltype(h)::index_type>,
-      decltype(index_order_g)> S{g, h, vertex_comp, edge_comp, index_order_g};
+      reduced_compatibility_matrix2<typename decltype(g)::index_type, typename H::index_type>,
+      decltype(index_order_g),
+      worklist_refinement<typename decltype(g)::index_type, typename H::index_type>> S{g, h, domain.predicate(), edge_comp, index_order_g};
   
-  explore(S, callback);
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
 }
 
 template <
+    typename Statistics = no_statistics,
     typename G_,
     typename H_,
     typename Callback,
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate>
-void ullimp_ind(
+search_statistics ullimp_alldifferent_ind(
     G_ const & g_,
     H_ const & h_,
     Callback callback,
     VertexEquivalencePredicate vertex_comp,
-    EdgeEquivalencePredicate edge_comp) {
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
   
   adjacency_listmat<typename G_::index_type> galm{g_};
   //auto index_order_g = vertex_order_RDEG_CNC(galm);
   auto index_order_g = vertex_order_GreatestConstraintFirst(galm);
   
   ordered_adjacency_listmat_with_not_after<typename G_::index_type> g{g_, index_order_g};
-  adjacency_listmat_with_not<typename H_::index_type> h{h_};
+  using H = csr_adjacency_listmat_with_not<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
   
   ullimp_state_ind<
       decltype(g),
-      decltype(h),
-      VertexEquivalencePredicate,
+      H,
+      typename decltype(domain)::predicate_type,
+      EdgeEquivalencePredicate,
+      reduced_compatibility_matrix2<typename decltype(g)::index_type, typename H::index_type>,
+      decltype(index_order_g),
+      worklist_refinement<typename decltype(g)::index_type, typename H::index_type>,
+      alldifferent_filter<typename decltype(g)::index_type, typename H::index_type>> S{g, h, domain.predicate(), edge_comp, index_order_g};
+  
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
+}
+
+template <
+    typename Statistics = no_statistics,
+    typename G_,
+    typename H_,
+    typename Callback,
+    typename VertexEquivalencePredicate,
+    typename EdgeEquivalencePredicate>
+search_statistics ullimp_bit_mono(
+    G_ const & g_,
+    H_ const & h_,
+    Callback callback,
+    VertexEquivalencePredicate vertex_comp,
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
+  adjacency_listmat<typename G_::index_type> g{g_};
+  using H = csr_adjacency_list<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  using A = bit_adjacency<typename H_::index_type>;
+  A const & a = target_representation<A>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
+  
+  auto index_order_g = vertex_order_GreatestConstraintFirst(g);
+  
+  ullimp_bit_state_mono<
+      decltype(g),
+      H,
+      typename decltype(domain)::predicate_type,
+      EdgeEquivalencePredicate,
+      word_compatibility_matrix<typename decltype(g)::index_type, typename H::index_type>,
+      decltype(index_order_g)> S{g, h, a, domain.predicate(), edge_comp, index_order_g};
+  
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
+}
+
+template <
+    typename Statistics = no_statistics,
+    typename G_,
+    typename H_,
+    typename Callback,
+    typename VertexEquivalencePredicate,
+    typename EdgeEquivalencePredicate>
+search_statistics ullimp_bit_ind(
+    G_ const & g_,
+    H_ const & h_,
+    Callback callback,
+    VertexEquivalencePredicate vertex_comp,
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
+  adjacency_listmat<typename G_::index_type> g{g_};
+  using H = csr_adjacency_list<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  using A = bit_adjacency<typename H_::index_type>;
+  A const & a = target_representation<A>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
+  
+  auto index_order_g = vertex_order_GreatestConstraintFirst(g);
+  
+  ullimp_bit_state_ind<
+      decltype(g),
+      H,
+      typename decltype(domain)::predicate_type,
       EdgeEquivalencePredicate,
-      reduced_compatibility_matrix2<typename decltype(g)::index_type, typename decltype(h)::index_type>,
-      decltype(index_order_g)> S{g, h, vertex_comp, edge_comp, index_order_g};
+      word_compatibility_matrix<typename decltype(g)::index_type, typename H::index_type>,
+      decltype(index_order_g)> S{g, h, a, domain.predicate(), edge_comp, index_order_g};
   
-  explore(S, callback);
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
 }
 
 template <
+    typename Statistics = no_statistics,
     typename G_,
     typename H_,
     typename Callback,
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate>
-void ullimp_no_after_ind(
+search_statistics ullimp_no_after_ind(
     G_ const & g_,
     H_ const & h_,
     Callback callback,
     VertexEquivalencePredicate vertex_comp,
-    EdgeEquivalencePredicate edge_comp) {
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
   
   adjacency_listmat_with_not<typename G_::index_type> g{g_};
-  adjacency_listmat_with_not<typename H_::index_type> h{h_};
+  using H = csr_adjacency_listmat_with_not<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
   
   auto index_order_g = vertex_order_GreatestConstraintFirst(g);
   
   ullimp_no_after_state_ind<
       decltype(g),
-      decltype(h),
-      VertexEquivalencePredicate,
+      H,
+      typename decltype(domain)::predicate_type,
       EdgeEquivalencePredicate,
-      reduced_compatibility_matrix2<typename decltype(g)::index_type, typename decltype(h)::index_type>,
-      decltype(index_order_g)> S{g, h, vertex_comp, edge_comp, index_order_g};
+      reduced_compatibility_matrix2<typename decltype(g)::index_type, typename H::index_type>,
+      decltype(index_order_g),
+      sweep_refinement<typename decltype(g)::index_type, typename H::index_type, false>> S{g, h, domain.predicate(), edge_comp, index_order_g};
   
-  explore(S, callback);
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
 }
 
 template <
+    typename Statistics = no_statistics,
     typename G_,
     typename H_,
     typename Callback,
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate>
-void ullimp2_ind(
+search_statistics ullimp2_ind(
     G_ const & g_,
     H_ const & h_,
     Callback callback,
     VertexEquivalencePredicate vertex_comp,
-    EdgeEquivalencePredicate edge_comp) {
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
   
   adjacency_listmat<typename G_::index_type> galm{g_};
   auto index_order_g = vertex_order_RDEG_CNC(galm);
   
   adjacency_matrix<typename G_::index_type> g{g_};
-  adjacency_matrix<typename H_::index_type> h{h_};
+  using H = adjacency_matrix<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
   
   ullimp2_state_ind<
       decltype(g),
-      decltype(h),
-      VertexEquivalencePredicate,
+      H,
+      typename decltype(domain)::predicate_type,
       EdgeEquivalencePredicate,
-      compatibility_matrix<typename decltype(g)::index_type, typename decltype(h)::index_type>,
-      decltype(index_order_g)> S{g, h, vertex_comp, edge_comp, index_order_g};
+      trail_compatibility_matrix<typename decltype(g)::index_type, typename H::index_type>,
+      decltype(index_order_g)> S{g, h, domain.predicate(), edge_comp, index_order_g};
   
-  explore(S, callback);
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
 }
 
 template <
+    typename Statistics = no_statistics,
     typename G_,
     typename H_,
     typename Callback,
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate>
-void ullimp3_ind(
+search_statistics ullimp3_ind(
     G_ const & g_,
     H_ const & h_,
     Callback callback,
     VertexEquivalencePredicate vertex_comp,
-    EdgeEquivalencePredicate edge_comp) {
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
   
   adjacency_listmat<typename G_::index_type> galm{g_};
   //auto index_order_g = vertex_order_RDEG_CNC(galm);
   auto index_order_g = vertex_order_GreatestConstraintFirst(galm);
   
   adjacency_matrix<typename G_::index_type> g{g_};
-  adjacency_matrix<typename H_::index_type> h{h_};
+  using H = adjacency_matrix<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
   
   ullimp3_state_ind<
       decltype(g),
-      decltype(h),
-      VertexEquivalencePredicate,
+      H,
+      typename decltype(domain)::predicate_type,
       EdgeEquivalencePredicate,
-      decltype(index_order_g)> S{g, h, vertex_comp, edge_comp, index_order_g};
+      decltype(index_order_g)> S{g, h, domain.predicate(), edge_comp, index_order_g};
   
-  explore(S, callback);
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
 }
 
 template <
+    typename Statistics = no_statistics,
     typename G_,
     typename H_,
     typename Callback,
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate>
-void ullimp4_mono(
+search_statistics ullimp4_mono(
     G_ const & g_,
     H_ const & h_,
     Callback callback,
     VertexEquivalencePredicate vertex_comp,
-    EdgeEquivalencePredicate edge_comp) {
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
   
   adjacency_listmat<typename G_::index_type> galm{g_};
   auto index_order_g = vertex_order_RDEG_CNC(galm);
   
   ordered_adjacency_list<typename G_::index_type> g(g_, index_order_g);
-  adjacency_listmat<typename H_::index_type> h{h_};
+  using H = csr_adjacency_listmat<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
   
   ullimp4_state_mono<
       decltype(g),
-      decltype(h),
-      VertexEquivalencePredicate,
+      H,
+      typename decltype(domain)::predicate_type,
       EdgeEquivalencePredicate,
-      decltype(index_order_g)> S{g, h, vertex_comp, edge_comp, index_order_g};
+      decltype(index_order_g)> S{g, h, domain.predicate(), edge_comp, index_order_g};
   
-  explore(S, callback);
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
 }
 
 template <
+    typename Statistics = no_statistics,
     typename G_,
     typename H_,
     typename Callback,
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate>
-void ullimp4_ind(
+search_statistics ullimp4_ind(
     G_ const & g_,
     H_ const & h_,
     Callback callback,
     VertexEquivalencePredicate vertex_comp,
-    EdgeEquivalencePredicate edge_comp) {
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
   
   adjacency_listmat<typename G_::index_type> galm{g_};
   //auto index_order_g = vertex_order_GreatestConstraintFirst(galm);
   auto index_order_g = vertex_order_GreatestConstraintFirst(galm);
   
   ordered_adjacency_list<typename G_::index_type> g(g_, index_order_g);
-  adjacency_listmat<typename H_::index_type> h{h_};
+  using H = csr_adjacency_listmat<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
   
   ullimp4_state_ind<
       decltype(g),
-      decltype(h),
-      VertexEquivalencePredicate,
+      H,
+      typename decltype(domain)::predicate_type,
       EdgeEquivalencePredicate,
-      decltype(index_order_g)> S{g, h, vertex_comp, edge_comp, index_order_g};
+      decltype(index_order_g)> S{g, h, domain.predicate(), edge_comp, index_order_g};
   
-  explore(S, callback);
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
 }
 
 template <
+    typename Statistics = no_statistics,
     typename G_,
     typename H_,
     typename Callback,
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate>
-void ullimp4_ind2(
+search_statistics ullimp4_ind2(
     G_ const & g_,
     H_ const & h_,
     Callback callback,
     VertexEquivalencePredicate vertex_comp,
-    EdgeEquivalencePredicate edge_comp) {
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
   
   adjacency_listmat<typename G_::index_type> galm{g_};
   auto index_order_g = vertex_order_GreatestConstraintFirst(galm);
   
   ordered_adjacency_list<typename G_::index_type> g(g_, index_order_g);
-  adjacency_listmat<typename H_::index_type> h{h_};
+  using H = csr_adjacency_listmat<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
   
   ullimp4_state_ind2<
       decltype(g),
-      decltype(h),
-      VertexEquivalencePredicate,
+      H,
+      typename decltype(domain)::predicate_type,
       EdgeEquivalencePredicate,
-      decltype(index_order_g)> S{g, h, vertex_comp, edge_comp, index_order_g};
+      decltype(index_order_g)> S{g, h, domain.predicate(), edge_comp, index_order_g};
   
-  explore(S, callback);
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
 }
 
 template <
+    typename Statistics = no_statistics,
     typename G_,
     typename H_,
     typename Callback,
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate>
-void simple_mono(
+search_statistics simple_mono(
     G_ const & g_,
     H_ const & h_,
     Callback callback,
     VertexEquivalencePredicate vertex_comp,
-    EdgeEquivalencePredicate edge_comp) {
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
   adjacency_listmat<typename G_::index_type> g{g_};
-  adjacency_listmat<typename H_::index_type> h{h_};
+  using H = adjacency_listmat<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
 
   auto index_order_g = vertex_order_DEG(g);
   
   simple_state_mono<
       decltype(g),
-      decltype(h),
-      VertexEquivalencePredicate,
+      H,
+      typename decltype(domain)::predicate_type,
       EdgeEquivalencePredicate,
-      decltype(index_order_g)> S{g, h, vertex_comp, edge_comp, index_order_g};
+      decltype(index_order_g)> S{g, h, domain.predicate(), edge_comp, index_order_g};
   
-  explore(S, callback);
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
 }
 
 template <
+    typename Statistics = no_statistics,
     typename G_,
     typename H_,
     typename Callback,
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate>
-void simple_ind(
+search_statistics simple_ind(
     G_ const & g_,
     H_ const & h_,
     Callback callback,
     VertexEquivalencePredicate vertex_comp,
-    EdgeEquivalencePredicate edge_comp) {
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
   adjacency_listmat<typename G_::index_type> g{g_};
-  adjacency_listmat<typename H_::index_type> h{h_};
+  using H = adjacency_listmat<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
 
   auto index_order_g = vertex_order_GreatestConstraintFirst(g);
   
   simple_state_ind<
       decltype(g),
-      decltype(h),
-      VertexEquivalencePredicate,
+      H,
+      typename decltype(domain)::predicate_type,
       EdgeEquivalencePredicate,
-      decltype(index_order_g)> S{g, h, vertex_comp, edge_comp, index_order_g};
+      decltype(index_order_g)> S{g, h, domain.predicate(), edge_comp, index_order_g};
   
-  explore(S, callback);
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
 }
 
 template <
+    typename Statistics = no_statistics,
     typename G_,
     typename H_,
     typename Callback,
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate>
-void simple_ind2(
+search_statistics simple_ind2(
     G_ const & g_,
     H_ const & h_,
     Callback callback,
     VertexEquivalencePredicate vertex_comp,
-    EdgeEquivalencePredicate edge_comp) {
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
   adjacency_listmat<typename G_::index_type> g{g_};
-  adjacency_listmat<typename H_::index_type> h{h_};
+  using H = adjacency_listmat<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
 
   auto index_order_g = vertex_order_RDEG_CNC(g);
   
   simple_state_ind2<
       decltype(g),
-      decltype(h),
-      VertexEquivalencePredicate,
+      H,
+      typename decltype(domain)::predicate_type,
       EdgeEquivalencePredicate,
-      decltype(index_order_g)> S{g, h, vertex_comp, edge_comp, index_order_g};
+      decltype(index_order_g)> S{g, h, domain.predicate(), edge_comp, index_order_g};
   
-  explore(S, callback);
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
 }
 
 template <
+    typename Statistics = no_statistics,
     typename G_,
     typename H_,
     typename Callback,
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate>
-void simple_ind3(
+search_statistics simple_ind3(
     G_ const & g_,
     H_ const & h_,
     Callback callback,
     VertexEquivalencePredicate vertex_comp,
-    EdgeEquivalencePredicate edge_comp) {
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
   adjacency_listmat<typename G_::index_type> g{g_};
-  adjacency_listmat<typename H_::index_type> h{h_};
+  using H = adjacency_listmat<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
 
   auto index_order_g = vertex_order_RDEG_CNC(g);
   
   simple_state_ind3<
       decltype(g),
-      decltype(h),
-      VertexEquivalencePredicate,
+      H,
+      typename decltype(domain)::predicate_type,
+      EdgeEquivalencePredicate,
+      decltype(index_order_g)> S{g, h, domain.predicate(), edge_comp, index_order_g};
+  
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
+}
+
+template <
+    typename Statistics = no_statistics,
+    typename G_,
+    typename H_,
+    typename Callback,
+    typename VertexEquivalencePredicate,
+    typename EdgeEquivalencePredicate>
+search_statistics ri_ind(
+    G_ const & g_,
+    H_ const & h_,
+    Callback callback,
+    VertexEquivalencePredicate vertex_comp,
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
+  adjacency_list<typename G_::index_type> g{g_};
+  using H = csr_adjacency_listmat<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
+
+  auto index_order_g = vertex_order_GreatestConstraintFirst(g);
+  
+  ri_state_ind<
+      decltype(g),
+      H,
+      typename decltype(domain)::predicate_type,
       EdgeEquivalencePredicate,
-      decltype(index_order_g)> S{g, h, vertex_comp, edge_comp, index_order_g};
+      decltype(index_order_g)> S{g, h, domain.predicate(), edge_comp, index_order_g};
   
-  explore(S, callback);
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
 }
 
 template <
+    typename Statistics = no_statistics,
     typename G_,
     typename H_,
     typename Callback,
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate>
-void ri_ind(
+search_statistics ri_sparse_ind(
     G_ const & g_,
     H_ const & h_,
     Callback callback,
     VertexEquivalencePredicate vertex_comp,
-    EdgeEquivalencePredicate edge_comp) {
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
   adjacency_list<typename G_::index_type> g{g_};
-  adjacency_listmat<typename H_::index_type> h{h_};
+  using H = sparse_adjacency_listmat<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
 
   auto index_order_g = vertex_order_GreatestConstraintFirst(g);
   
   ri_state_ind<
       decltype(g),
-      decltype(h),
-      VertexEquivalencePredicate,
+      H,
+      typename decltype(domain)::predicate_type,
       EdgeEquivalencePredicate,
-      decltype(index_order_g)> S{g, h, vertex_comp, edge_comp, index_order_g};
+      decltype(index_order_g)> S{g, h, domain.predicate(), edge_comp, index_order_g};
   
-  explore(S, callback);
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
 }
 
 template <
+    typename Statistics = no_statistics,
     typename G_,
     typename H_,
     typename Callback,
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate>
-void ri_RDEG_CNC_ind(
+search_statistics ri_RDEG_CNC_ind(
     G_ const & g_,
     H_ const & h_,
     Callback callback,
     VertexEquivalencePredicate vertex_comp,
-    EdgeEquivalencePredicate edge_comp) {
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
   adjacency_listmat<typename G_::index_type> g{g_};
-  adjacency_listmat<typename H_::index_type> h{h_};
+  using H = csr_adjacency_listmat<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
 
   auto index_order_g = vertex_order_RDEG_CNC(g);
   
   ri_state_ind<
       decltype(g),
-      decltype(h),
-      VertexEquivalencePredicate,
+      H,
+      typename decltype(domain)::predicate_type,
       EdgeEquivalencePredicate,
-      decltype(index_order_g)> S{g, h, vertex_comp, edge_comp, index_order_g};
+      decltype(index_order_g)> S{g, h, domain.predicate(), edge_comp, index_order_g};
   
-  explore(S, callback);
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
 }
 
 template <
+    typename Statistics = no_statistics,
     typename G_,
     typename H_,
     typename Callback,
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate>
-void ri_RDEG_ind(
+search_statistics ri_RDEG_ind(
     G_ const & g_,
     H_ const & h_,
     Callback callback,
     VertexEquivalencePredicate vertex_comp,
-    EdgeEquivalencePredicate edge_comp) {
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
   adjacency_list<typename G_::index_type> g{g_};
-  adjacency_listmat<typename H_::index_type> h{h_};
+  using H = csr_adjacency_listmat<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
 
   auto index_order_g = vertex_order_RDEG(g);
   
   ri_state_ind<
       decltype(g),
-      decltype(h),
-      VertexEquivalencePredicate,
+      H,
+      typename decltype(domain)::predicate_type,
       EdgeEquivalencePredicate,
-      decltype(index_order_g)> S{g, h, vertex_comp, edge_comp, index_order_g};
+      decltype(index_order_g)> S{g, h, domain.predicate(), edge_comp, index_order_g};
   
-  explore(S, callback);
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
 }
 
 template <
+    typename Statistics = no_statistics,
     typename G_,
     typename H_,
     typename Callback,
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate>
-void ri_lookahead_ind(
+search_statistics ri_lookahead_ind(
     G_ const & g_,
     H_ const & h_,
     Callback callback,
     VertexEquivalencePredicate vertex_comp,
-    EdgeEquivalencePredicate edge_comp) {
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
   adjacency_list<typename G_::index_type> g{g_};
-  adjacency_listmat<typename H_::index_type> h{h_};
+  using H = csr_adjacency_listmat<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
 
   auto index_order_g = vertex_order_GreatestConstraintFirst(g);
   
   ri_lookahead_state_ind<
       decltype(g),
-      decltype(h),
-      VertexEquivalencePredicate,
+      H,
+      typename decltype(domain)::predicate_type,
       EdgeEquivalencePredicate,
-      decltype(index_order_g)> S{g, h, vertex_comp, edge_comp, index_order_g};
+      decltype(index_order_g)> S{g, h, domain.predicate(), edge_comp, index_order_g};
   
-  explore(S, callback);
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
 }
 
 template <
+    typename Statistics = no_statistics,
     typename G_,
     typename H_,
     typename Callback,
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate>
-void refined_ri_ind(
+search_statistics refined_ri_ind(
     G_ const & g_,
     H_ const & h_,
     Callback callback,
     VertexEquivalencePredicate vertex_comp,
-    EdgeEquivalencePredicate edge_comp) {
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
   adjacency_list<typename G_::index_type> g{g_};
-  adjacency_listmat<typename H_::index_type> h{h_};
+  using H = adjacency_listmat<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
 
   auto index_order_g = vertex_order_GreatestConstraintFirst(g);
   
   refined_ri_state_ind<
       decltype(g),
-      decltype(h),
-      VertexEquivalencePredicate,
+      H,
+      typename decltype(domain)::predicate_type,
       EdgeEquivalencePredicate,
-      decltype(index_order_g)> S{g, h, vertex_comp, edge_comp, index_order_g};
+      decltype(index_order_g)> S{g, h, domain.predicate(), edge_comp, index_order_g};
   
-  explore(S, callback);
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
 }
 
 template <
+    typename Statistics = no_statistics,
     typename G_,
     typename H_,
     typename Callback,
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate>
-void ri_dynamic_parent_ind(
+search_statistics ri_dynamic_parent_ind(
     G_ const & g_,
     H_ const & h_,
     Callback callback,
     VertexEquivalencePredicate vertex_comp,
-    EdgeEquivalencePredicate edge_comp) {
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
     
   adjacency_list<typename G_::index_type> gal{g_};
   auto index_order_g = vertex_order_GreatestConstraintFirst(gal);
   
   ordered_adjacency_listmat<typename G_::index_type> g{g_, index_order_g};
-  adjacency_listmat<typename H_::index_type> h{h_};
+  using H = adjacency_listmat<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
   
   ri_dynamic_parent_state_ind<
       decltype(g),
-      decltype(h),
-      VertexEquivalencePredicate,
+      H,
+      typename decltype(domain)::predicate_type,
+      EdgeEquivalencePredicate,
+      decltype(index_order_g)> S{g, h, domain.predicate(), edge_comp, index_order_g};
+  
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
+}
+
+template <
+    typename Statistics = no_statistics,
+    typename G_,
+    typename H_,
+    typename Callback,
+    typename VertexEquivalencePredicate,
+    typename EdgeEquivalencePredicate>
+search_statistics ri2_ind(
+    G_ const & g_,
+    H_ const & h_,
+    Callback callback,
+    VertexEquivalencePredicate vertex_comp,
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
+  adjacency_list<typename G_::index_type> gal{g_};
+
+  auto index_order_g = vertex_order_GreatestConstraintFirst(gal);
+  
+  ordered_adjacency_list<typename G_::index_type> g(g_, index_order_g);
+  using H = csr_adjacency_listmat<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
+  
+  ri2_state_ind<
+      decltype(g),
+      H,
+      typename decltype(domain)::predicate_type,
       EdgeEquivalencePredicate,
-      decltype(index_order_g)> S{g, h, vertex_comp, edge_comp, index_order_g};
+      decltype(index_order_g)> S{g, h, domain.predicate(), edge_comp, index_order_g};
   
-  explore(S, callback);
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
 }
 
 template <
+    typename Statistics = no_statistics,
     typename G_,
     typename H_,
     typename Callback,
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate>
-void ri2_ind(
+search_statistics ri2_sparse_ind(
     G_ const & g_,
     H_ const & h_,
     Callback callback,
     VertexEquivalencePredicate vertex_comp,
-    EdgeEquivalencePredicate edge_comp) {
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
   adjacency_list<typename G_::index_type> gal{g_};
 
   auto index_order_g = vertex_order_GreatestConstraintFirst(gal);
   
   ordered_adjacency_list<typename G_::index_type> g(g_, index_order_g);
-  adjacency_listmat<typename H_::index_type> h{h_};
+  using H = sparse_adjacency_listmat<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
   
   ri2_state_ind<
       decltype(g),
-      decltype(h),
-      VertexEquivalencePredicate,
+      H,
+      typename decltype(domain)::predicate_type,
       EdgeEquivalencePredicate,
-      decltype(index_order_g)> S{g, h, vertex_comp, edge_comp, index_order_g};
+      decltype(index_order_g)> S{g, h, domain.predicate(), edge_comp, index_order_g};
   
-  explore(S, callback);
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
 }
 
 template <
+    typename Statistics = no_statistics,
     typename G_,
     typename H_,
     typename Callback,
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate>
-void ri2_ind2(
+search_statistics ri2_ind2(
     G_ const & g_,
     H_ const & h_,
     Callback callback,
     VertexEquivalencePredicate vertex_comp,
-    EdgeEquivalencePredicate edge_comp) {
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
   adjacency_list<typename G_::index_type> gal{g_};
 
   auto index_order_g = vertex_order_GreatestConstraintFirst(gal);
   
   ordered_adjacency_list<typename G_::index_type> g(g_, index_order_g);
-  adjacency_listmat<typename H_::index_type> h{h_};
+  using H = csr_adjacency_listmat<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
   
   ri2_state_ind2<
       decltype(g),
-      decltype(h),
-      VertexEquivalencePredicate,
+      H,
+      typename decltype(domain)::predicate_type,
+      EdgeEquivalencePredicate,
+      decltype(index_order_g)> S{g, h, domain.predicate(), edge_comp, index_order_g};
+  
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
+}
+
+template <
+    typename Statistics = no_statistics,
+    typename G_,
+    typename H_,
+    typename Callback,
+    typename VertexEquivalencePredicate,
+    typename EdgeEquivalencePredicate>
+search_statistics ullimp_ri_ind(
+    G_ const & g_,
+    H_ const & h_,
+    Callback callback,
+    VertexEquivalencePredicate vertex_comp,
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
+  
+  adjacency_listmat<typename G_::index_type> galm{g_};
+  auto index_order_g = vertex_order_RDEG_CNC(galm);
+  
+  ordered_adjacency_listmat_with_not_after<typename G_::index_type> g{g_, index_order_g};
+  using H = csr_adjacency_listmat_with_not<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
+  
+  ullimp_ri_state_ind<
+      decltype(g),
+      H,
+      typename decltype(domain)::predicate_type,
       EdgeEquivalencePredicate,
-      decltype(index_order_g)> S{g, h, vertex_comp, edge_comp, index_order_g};
+      reduced_compatibility_matrix2<typename decltype(g)::index_type, typename H::index_type>,
+      decltype(index_order_g),
+      sweep_refinement<typename decltype(g)::index_type, typename H::index_type, false>> S{g, h, domain.predicate(), edge_comp, index_order_g};
   
-  explore(S, callback);
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
 }
 
 template <
+    typename Statistics = no_statistics,
     typename G_,
     typename H_,
     typename Callback,
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate>
-void ullimp_ri_ind(
+search_statistics ullimp_ri_worklist_ind(
     G_ const & g_,
     H_ const & h_,
     Callback callback,
     VertexEquivalencePredicate vertex_comp,
-    EdgeEquivalencePredicate edge_comp) {
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
   
   adjacency_listmat<typename G_::index_type> galm{g_};
   auto index_order_g = vertex_order_RDEG_CNC(galm);
   
   ordered_adjacency_listmat_with_not_after<typename G_::index_type> g{g_, index_order_g};
-  adjacency_listmat_with_not<typename H_::index_type> h{h_};
+  using H = csr_adjacency_listmat_with_not<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
   
   ullimp_ri_state_ind<
       decltype(g),
-      decltype(h),
-      VertexEquivalencePredicate,
+      H,
+      typename decltype(domain)::predicate_type,
       EdgeEquivalencePredicate,
-      reduced_compatibility_matrix2<typename decltype(g)::index_type, typename decltype(h)::index_type>,
-      decltype(index_order_g)> S{g, h, vertex_comp, edge_comp, index_order_g};
+      reduced_compatibility_matrix2<typename decltype(g)::index_type, typename H::index_type>,
+      decltype(index_order_g),
+      worklist_refinement<typename decltype(g)::index_type, typename H::index_type>> S{g, h, domain.predicate(), edge_comp, index_order_g};
   
-  explore(S, callback);
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
 }
 
 template <
+    typename Statistics = no_statistics,
     typename G_,
     typename H_,
     typename Callback,
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate>
-void dynamic_ind(
+search_statistics dynamic_ind(
     G_ const & g_,
     H_ const & h_,
     Callback callback,
     VertexEquivalencePredicate vertex_comp,
-    EdgeEquivalencePredicate edge_comp) {
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
   
   adjacency_listmat_with_not<typename G_::index_type> g{g_};
-  adjacency_listmat_with_not<typename H_::index_type> h{h_};
+  using H = adjacency_listmat_with_not<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
   
   dynamic_state_ind<
       decltype(g),
-      decltype(h),
-      VertexEquivalencePredicate,
-      EdgeEquivalencePredicate> S{g, h, vertex_comp, edge_comp};
+      H,
+      typename decltype(domain)::predicate_type,
+      EdgeEquivalencePredicate> S{g, h, domain.predicate(), edge_comp};
   
-  explore(S, callback);
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
 }
 
 template <
+    typename Statistics = no_statistics,
     typename G_,
     typename H_,
     typename Callback,
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate>
-void dynamic_sorted_vector_ind(
+search_statistics dynamic_sorted_vector_ind(
     G_ const & g_,
     H_ const & h_,
     Callback callback,
     VertexEquivalencePredicate vertex_comp,
-    EdgeEquivalencePredicate edge_comp) {
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
   
   orderable_adjacency_listmat<typename G_::index_type> g{g_};
-  adjacency_listmat_with_not<typename H_::index_type> h{h_};
+  using H = adjacency_listmat_with_not<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
   
   dynamic_sorted_vector_state_ind<
       decltype(g),
-      decltype(h),
-      VertexEquivalencePredicate,
-      EdgeEquivalencePredicate> S{g, h, vertex_comp, edge_comp};
+      H,
+      typename decltype(domain)::predicate_type,
+      EdgeEquivalencePredicate> S{g, h, domain.predicate(), edge_comp};
+  
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
+}
+
+template <
+    typename Statistics = no_statistics,
+    typename G_,
+    typename H_,
+    typename Callback,
+    typename VertexEquivalencePredicate,
+    typename EdgeEquivalencePredicate>
+search_statistics dynamic_mat_ind(
+    G_ const & g_,
+    H_ const & h_,
+    Callback callback,
+    VertexEquivalencePredicate vertex_comp,
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
+  
+  adjacency_listmat_with_not<typename G_::index_type> g{g_};
+  using H = adjacency_listmat_with_not<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
+  
+  dynamic_mat_state_ind<
+      decltype(g),
+      H,
+      typename decltype(domain)::predicate_type,
+      EdgeEquivalencePredicate,
+      reduced_compatibility_matrix2_with_count<typename decltype(g)::index_type, typename H::index_type>> S{g, h, domain.predicate(), edge_comp};
   
-  explore(S, callback);
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
 }
 
 template <
+    typename Statistics = no_statistics,
     typename G_,
     typename H_,
     typename Callback,
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate>
-void dynamic_mat_ind(
+search_statistics dynamic_mat_alldifferent_ind(
     G_ const & g_,
     H_ const & h_,
     Callback callback,
     VertexEquivalencePredicate vertex_comp,
-    EdgeEquivalencePredicate edge_comp) {
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
   
   adjacency_listmat_with_not<typename G_::index_type> g{g_};
-  adjacency_listmat_with_not<typename H_::index_type> h{h_};
+  using H = adjacency_listmat_with_not<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
   
   dynamic_mat_state_ind<
       decltype(g),
-      decltype(h),
-      VertexEquivalencePredicate,
+      H,
+      typename decltype(domain)::predicate_type,
       EdgeEquivalencePredicate,
-      reduced_compatibility_matrix2_with_count<typename decltype(g)::index_type, typename decltype(h)::index_type>> S{g, h, vertex_comp, edge_comp};
+      reduced_compatibility_matrix2_with_count<typename decltype(g)::index_type, typename H::index_type>,
+      alldifferent_filter<typename decltype(g)::index_type, typename H::index_type>> S{g, h, domain.predicate(), edge_comp};
   
-  explore(S, callback);
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
 }
 
 template <
+    typename Statistics = no_statistics,
     typename G_,
     typename H_,
     typename Callback,
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate>
-void dynamic_mat_orderable_ind(
+search_statistics dynamic_mat_orderable_ind(
     G_ const & g_,
     H_ const & h_,
     Callback callback,
     VertexEquivalencePredicate vertex_comp,
-    EdgeEquivalencePredicate edge_comp) {
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
   
   orderable_adjacency_listmat<typename G_::index_type> g{g_};
-  adjacency_listmat_with_not<typename H_::index_type> h{h_};
+  using H = adjacency_listmat_with_not<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
   
   dynamic_mat_orderable_state_ind<
       decltype(g),
-      decltype(h),
-      VertexEquivalencePredicate,
+      H,
+      typename decltype(domain)::predicate_type,
       EdgeEquivalencePredicate,
-      reduced_compatibility_matrix2_with_count<typename decltype(g)::index_type, typename decltype(h)::index_type>> S{g, h, vertex_comp, edge_comp};
+      reduced_compatibility_matrix2_with_count<typename decltype(g)::index_type, typename H::index_type>> S{g, h, domain.predicate(), edge_comp};
   
-  explore(S, callback);
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
 }
 
 template <
+    typename Statistics = no_statistics,
     typename G_,
     typename H_,
     typename Callback,
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate>
-void dynamic_mat_orderable_with_ri_degree_ind(
+search_statistics dynamic_mat_orderable_with_ri_degree_ind(
     G_ const & g_,
     H_ const & h_,
     Callback callback,
     VertexEquivalencePredicate vertex_comp,
-    EdgeEquivalencePredicate edge_comp) {
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
   
   orderable_adjacency_listmat_with_ri_degree<typename G_::index_type> g{g_};
-  adjacency_listmat_with_not<typename H_::index_type> h{h_};
+  using H = adjacency_listmat_with_not<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
   
   dynamic_mat_orderable_with_ri_degree_state_ind<
       decltype(g),
-      decltype(h),
-      VertexEquivalencePredicate,
+      H,
+      typename decltype(domain)::predicate_type,
       EdgeEquivalencePredicate,
-      reduced_compatibility_matrix2_with_count<typename decltype(g)::index_type, typename decltype(h)::index_type>> S{g, h, vertex_comp, edge_comp};
+      reduced_compatibility_matrix2_with_count<typename decltype(g)::index_type, typename H::index_type>> S{g, h, domain.predicate(), edge_comp};
   
-  explore(S, callback);
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
 }
 
 template <
+    typename Statistics = no_statistics,
     typename G_,
     typename H_,
     typename Callback,
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate>
-void dynamic_sorted_vector_new_ind(
+search_statistics dynamic_sorted_vector_new_ind(
     G_ const & g_,
     H_ const & h_,
     Callback callback,
     VertexEquivalencePredicate vertex_comp,
-    EdgeEquivalencePredicate edge_comp) {
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
   
   adjacency_listmat<typename G_::index_type> g{g_};
-  adjacency_listmat_with_not<typename H_::index_type> h{h_};
+  using H = adjacency_listmat_with_not<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
   
   dynamic_sorted_vector_new_state_ind<
       decltype(g),
-      decltype(h),
-      VertexEquivalencePredicate,
-      EdgeEquivalencePredicate> S{g, h, vertex_comp, edge_comp};
+      H,
+      typename decltype(domain)::predicate_type,
+      EdgeEquivalencePredicate> S{g, h, domain.predicate(), edge_comp};
   
-  explore(S, callback);
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
 }
 
 template <
+    typename Statistics = no_statistics,
     typename G_,
     typename H_,
     typename Callback,
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate>
-void dynamic_linked_mat_orderable_ind(
+search_statistics dynamic_linked_mat_orderable_ind(
     G_ const & g_,
     H_ const & h_,
     Callback callback,
     VertexEquivalencePredicate vertex_comp,
-    EdgeEquivalencePredicate edge_comp) {
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
   
   adjacency_listmat<typename G_::index_type> g{g_};
-  adjacency_listmat_with_not<typename H_::index_type> h{h_};
+  using H = adjacency_listmat_with_not<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
   
   dynamic_linked_mat_orderable_state_ind<
       decltype(g),
-      decltype(h),
-      VertexEquivalencePredicate,
+      H,
+      typename decltype(domain)::predicate_type,
       EdgeEquivalencePredicate,
-      reduced_compatibility_linked_matrix<typename decltype(g)::index_type, typename decltype(h)::index_type>> S{g, h, vertex_comp, edge_comp};
+      reduced_compatibility_linked_matrix<typename decltype(g)::index_type, typename H::index_type>> S{g, h, domain.predicate(), edge_comp};
   
-  explore(S, callback);
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
 }
 
 template <
+    typename Statistics = no_statistics,
     typename G_,
     typename H_,
     typename Callback,
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate>
-void dynamic_mat_pushable_ind(
+search_statistics dynamic_mat_pushable_ind(
     G_ const & g_,
     H_ const & h_,
     Callback callback,
     VertexEquivalencePredicate vertex_comp,
-    EdgeEquivalencePredicate edge_comp) {
+    EdgeEquivalencePredicate edge_comp,
+    unsigned num_threads = 1,
+    search_limits * limits = nullptr) {
   
   pushable_adjacency_listmat<typename G_::index_type> g{g_};
-  adjacency_listmat_with_not<typename H_::index_type> h{h_};
+  using H = adjacency_listmat_with_not<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp, limits);
   
   dynamic_mat_pushable_state_ind<
       decltype(g),
-      decltype(h),
-      VertexEquivalencePredicate,
+      H,
+      typename decltype(domain)::predicate_type,
       EdgeEquivalencePredicate,
-      reduced_compatibility_matrix2_with_count<typename decltype(g)::index_type, typename decltype(h)::index_type>> S{g, h, vertex_comp, edge_comp};
+      reduced_compatibility_matrix2_with_count<typename decltype(g)::index_type, typename H::index_type>> S{g, h, domain.predicate(), edge_comp};
   
-  explore(S, callback);
+  return parallel_explore<Statistics>(S, callback, num_threads, limits);
 }
 
 #endif  // PREDEFINED_H_
@@ -0,0 +1,53 @@
+#ifndef PREDEFINED_GENERATORS_H_
+#define PREDEFINED_GENERATORS_H_
+
+// C++20 coroutine counterparts of predefined.h entry points:
+//
+//   for (auto const & e : ri_ind_gen(g, h, vertex_comp, edge_comp)) ...
+//
+// yields one embedding_view per solution, pointing into the search state,
+// so it is only valid until the loop moves on. g and h are referred to for
+// as long as the generator lives.
+
+#include "adjacency_list.h"
+#include "adjacency_listmat.h"
+#include "csr_adjacency_listmat.h"
+#include "ri_state.h"
+#include "vertex_order.h"
+#include "prepared_target.h"
+#include "initial_domain.h"
+#include "explore_cursor.h"
+#include "embedding_view.h"
+#include "generator.h"
+
+template <
+    typename G_,
+    typename H_,
+    typename VertexEquivalencePredicate,
+    typename EdgeEquivalencePredicate>
+generator<embedding_view<typename G_::index_type, typename H_::index_type>> ri_ind_gen(
+    G_ const & g_,
+    H_ const & h_,
+    VertexEquivalencePredicate vertex_comp,
+    EdgeEquivalencePredicate edge_comp) {
+  adjacency_list<typename G_::index_type> g{g_};
+  using H = csr_adjacency_listmat<typename H_::index_type>;
+  H const & h = target_representation<H>(h_);
+  auto domain = make_initial_domain(g_, h_, vertex_comp);
+
+  auto index_order_g = vertex_order_GreatestConstraintFirst(g);
+
+  ri_state_ind<
+      decltype(g),
+      H,
+      typename decltype(domain)::predicate_type,
+      EdgeEquivalencePredicate,
+      decltype(index_order_g)> S{g, h, domain.predicate(), edge_comp, index_order_g};
+
+  explore_cursor<decltype(S)> cursor{S};
+  while (auto s = cursor.next()) {
+    co_yield s->embedding();
+  }
+}
+
+#endif  // PREDEFINED_GENERATORS_H_
@@ -0,0 +1,108 @@
+#ifndef PREPARED_TARGET_H_
+#define PREPARED_TARGET_H_
+
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <utility>
+
+#include "adjacency_matrix.h"
+#include "adjacency_listmat.h"
+#include "adjacency_listmat_with_not.h"
+#include "csr_adjacency_list.h"
+#include "csr_adjacency_listmat.h"
+#include "csr_adjacency_listmat_with_not.h"
+#include "sparse_adjacency_listmat.h"
+#include "neighborhood_signature.h"
+#include "degree_buckets.h"
+#include "bit_adjacency.h"
+
+// A target graph together with every representation the predefined.h
+// algorithms build from it. Each representation is built on first use,
+// once, and then shared read-only by all queries and threads, so many
+// patterns can be matched against one large target without rebuilding
+// its n*n bitmaps and adjacency lists per call. Pass it wherever a
+// predefined.h function expects h.
+//
+// Target vertices are bucketed by degree only. Labels are not part of the
+// graph types; a match sees them only through vertex_comp, which may
+// differ per query, so there is nothing to bucket them by. Likewise the
+// vertex orders the algorithms use are orders of the pattern, and the
+// only per-target order a state keeps is the identity list of h's
+// vertices, which costs O(n) to fill.
+template <typename H_>
+class prepared_target {
+ public:
+  using graph_type = H_;
+  using index_type = typename H_::index_type;
+
+ private:
+  template <typename Representation>
+  struct slot {
+    std::once_flag once;
+    std::unique_ptr<Representation const> value;
+  };
+
+  H_ h;
+
+  mutable std::tuple<
+      slot<adjacency_matrix<index_type>>,
+      slot<adjacency_listmat<index_type>>,
+      slot<adjacency_listmat_with_not<index_type>>,
+      slot<csr_adjacency_list<index_type>>,
+      slot<csr_adjacency_listmat<index_type>>,
+      slot<csr_adjacency_listmat_with_not<index_type>>,
+      slot<sparse_adjacency_listmat<index_type>>,
+      slot<neighborhood_signature<index_type>>,
+      slot<degree_buckets<index_type>>,
+      slot<bit_adjacency<index_type>>> slots;
+
+ public:
+  explicit prepared_target(H_ h)
+      : h(std::move(h)) {
+  }
+
+  prepared_target(prepared_target const &) = delete;
+  prepared_target & operator=(prepared_target const &) = delete;
+
+  H_ const & graph() const {
+    return h;
+  }
+
+  index_type num_vertices() const {
+    return h.num_vertices();
+  }
+
+  template <typename Representation>
+  Representation const & get() const {
+    auto & s = std::get<slot<Representation>>(slots);
+    std::call_once(s.once, [this, &s]() {
+      s.value.reset(new Representation(h));
+    });
+    return *s.value;
+  }
+
+  // builds the given representations now rather than on first use
+  template <typename... Representations>
+  void build() const {
+    (get<Representations>(), ...);
+  }
+};
+
+// The representation R of a target: built on the spot from a plain graph,
+// looked up in a prepared_target.
+template <
+    typename R,
+    typename H>
+R target_representation(H const & h) {
+  return R(h);
+}
+
+template <
+    typename R,
+    typename H>
+R const & target_representation(prepared_target<H> const & h) {
+  return h.template get<R>();
+}
+
+#endif  // PREPARED_TARGET_H_
@@ -1,6 +1,7 @@
 #ifndef PUSHABLE_ADJACENCY_LISTMAT_H_
 #define PUSHABLE_ADJACENCY_LISTMAT_H_
 
+#include <cstddef>
 #include <iterator>
 #include <algorithm>
 #include <vector>
@@ -38,11 +39,11 @@ class pushable_adjacency_listmat {
   std::vector<bool> mat;
   
   void set(index_type i, index_type j) {
-    mat[i*n + j] = true;
+    mat[static_cast<std::size_t>(i)*n + j] = true;
   }
   
   bool get(index_type i, index_type j) const {
-    return mat[i*n + j];
+    return mat[static_cast<std::size_t>(i)*n + j];
   }
   
  public:
@@ -50,7 +51,7 @@ class pushable_adjacency_listmat {
   explicit pushable_adjacency_listmat(G const & g)
       : n{g.num_vertices()},
         nodes(n),
-        mat(n * n) {
+        mat(static_cast<std::size_t>(n)*n) {
     for (index_type u=0; u<n; ++u) {
       for (auto v : g.adjacent_vertices(u)) {
         set(u, v);
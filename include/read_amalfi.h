@@ -1,23 +1,35 @@
+#ifndef READ_AMALFI_H_
+#define READ_AMALFI_H_
+
 #include <cstdint>
 
 #include <istream>
 
-uint16_t read_word(std::istream & in) {
-  uint16_t x = static_cast<unsigned char>(in.get());
-  x |= static_cast<uint16_t>(in.get()) << 8;
+// Word is the width of every count and id in the file: uint16_t for the
+// original AMALFI databases, wider for the same layout on larger graphs.
+template <typename Word = uint16_t>
+Word read_word(std::istream & in) {
+  Word x = 0;
+  for (unsigned b=0; b<sizeof(Word); ++b) {
+    x |= static_cast<Word>(static_cast<unsigned char>(in.get())) << (8*b);
+  }
   return x;
 }
 
-template <typename G>
+template <
+    typename G,
+    typename Word = uint16_t>
 G read_amalfi(std::istream & in) {
-  auto n = read_word(in);
+  auto n = read_word<Word>(in);
   G g(n);
   for (decltype(n) u=0; u<n; ++u) {
-    auto cnt = read_word(in);
+    auto cnt = read_word<Word>(in);
     for (decltype(cnt) j=0; j<cnt; ++j) {
-      auto v = read_word(in);
+      auto v = read_word<Word>(in);
       g.add_edge(u, v);
     }
   }
   return g;
 }
+
+#endif  // READ_AMALFI_H_
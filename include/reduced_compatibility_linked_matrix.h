@@ -1,6 +1,7 @@
 #ifndef REDUCED_COMPATIBILITY_LINKED_MATRIX_H_
 #define REDUCED_COMPATIBILITY_LINKED_MATRIX_H_
 
+#include <cstddef>
 #include <iterator>
 #include <algorithm>
 #include <vector>
@@ -40,21 +41,34 @@ class reduced_compatibility_linked_matrix {
       : m{m},
         n{n},
         dummy(m),
-        data(m*n),
+        data(static_cast<std::size_t>(m)*n),
         count(m) {
     for (IndexG i=0; i<m; ++i) {
       for (IndexH j=0; j<n; ++j) {
-        auto idx = i*n + j;
+        auto idx = static_cast<std::size_t>(i)*n + j;
         data[idx].idx = j;
       }
     }
   }
   
+  // a copy links only the active cells and cannot revert past this point
+  reduced_compatibility_linked_matrix(reduced_compatibility_linked_matrix const & other)
+      : reduced_compatibility_linked_matrix(other.m, other.n) {
+    for (IndexG i=0; i<m; ++i) {
+      for (IndexH j=0; j<n; ++j) {
+        auto idx = static_cast<std::size_t>(i)*n + j;
+        data[idx].active = other.data[idx].active;
+      }
+    }
+    count = other.count;
+    init();
+  }
+  
   void init() {
     for (IndexG i=0; i<m; ++i) {
       node * prev = &dummy[i];
       for (IndexH j=0; j<n; ++j) {
-        auto idx = i*n + j;
+        auto idx = static_cast<std::size_t>(i)*n + j;
         if (get(i, j)) {
           prev->next = &data[idx];
           data[idx].prev = prev;
@@ -65,15 +79,15 @@ class reduced_compatibility_linked_matrix {
   }
 
   bool get(IndexG i, IndexH j) const {
-    return data[i*n + j].active;
+    return data[static_cast<std::size_t>(i)*n + j].active;
   }
   void set(IndexG i, IndexH j) {
-    auto idx = i*n + j;
+    auto idx = static_cast<std::size_t>(i)*n + j;
     data[idx].active = true;
     ++count[i];
   }
   void unset(IndexG i, IndexH j) {
-    auto idx = i*n + j;
+    auto idx = static_cast<std::size_t>(i)*n + j;
     if (data[idx].active) {
       history.push(idx);
       data[idx].active = false;
@@ -1,6 +1,7 @@
 #ifndef REDUCED_COMPATIBILITY_MATRIX_H_
 #define REDUCED_COMPATIBILITY_MATRIX_H_
 
+#include <cstddef>
 #include <iterator>
 #include <algorithm>
 #include <vector>
@@ -23,18 +24,25 @@ class reduced_compatibility_matrix {
   reduced_compatibility_matrix(IndexG m, IndexH n)
       : m{m},
         n{n},
-        data(m*n) {
+        data(static_cast<std::size_t>(m)*n) {
+  }
+  
+  // a copy starts with an empty history and cannot revert past this point
+  reduced_compatibility_matrix(reduced_compatibility_matrix const & other)
+      : m{other.m},
+        n{other.n},
+        data(other.data) {
   }
 
   bool get(IndexG i, IndexH j) const {
-    return data[i*n + j];
+    return data[static_cast<std::size_t>(i)*n + j];
   }
   void set(IndexG i, IndexH j) {
-    auto idx = i*n + j;
+    auto idx = static_cast<std::size_t>(i)*n + j;
     data[idx] = true;
   }
   void unset(IndexG i, IndexH j) {
-    auto idx = i*n + j;
+    auto idx = static_cast<std::size_t>(i)*n + j;
     if (data[idx]) {
       history.push(idx);
       data[idx] = false;
@@ -1,11 +1,14 @@
 #ifndef REDUCED_COMPATIBILITY_MATRIX2_H_
 #define REDUCED_COMPATIBILITY_MATRIX2_H_
 
+#include <cstddef>
 #include <iterator>
 #include <algorithm>
 #include <vector>
 #include <stack>
 
+#include "scratch_arena.h"
+
 template <
     typename IndexG,
     typename IndexH>
@@ -14,36 +17,49 @@ class reduced_compatibility_matrix2 {
   IndexG const m;
   IndexH const n;
   
-  std::vector<char> data;
+  scratch_vector<char> data;
   
-  std::vector</*typename decltype(data)::size_type*/int> history;
-  /*typename decltype(history)::size_type*/ int index;
-  std::vector</*typename decltype(history)::size_type*/int> shots;
-  /*typename decltype(shots)::size_type*/ int shotidx;
+  // history[0..index) are the cells unset along the current path and
+  // shots[0..shotidx) the history sizes at each advance()
+  scratch_vector<std::size_t> history;
+  std::size_t index;
+  std::vector<std::size_t> shots;
+  std::size_t shotidx;
 
  public:
   reduced_compatibility_matrix2(IndexG m, IndexH n)
       : m{m},
         n{n},
-        data(m*n),
-        history(m*n),
-        index{-1},
-        shots(m*n),
-        shotidx{-1} {
+        data(static_cast<std::size_t>(m)*n),
+        history(static_cast<std::size_t>(m)*n),
+        index{0},
+        shots(static_cast<std::size_t>(m)+1),
+        shotidx{0} {
+  }
+  
+  // a copy starts with an empty history and cannot revert past this point
+  reduced_compatibility_matrix2(reduced_compatibility_matrix2 const & other)
+      : m{other.m},
+        n{other.n},
+        data(other.data),
+        history(static_cast<std::size_t>(m)*n),
+        index{0},
+        shots(static_cast<std::size_t>(m)+1),
+        shotidx{0} {
   }
 
   bool get(IndexG i, IndexH j) const {
-    return data[i*n + j];
+    return data[static_cast<std::size_t>(i)*n + j];
   }
   void set(IndexG i, IndexH j) {
-    auto idx = i*n + j;
+    auto idx = static_cast<std::size_t>(i)*n + j;
     data[idx] = true;
   }
   void unset(IndexG i, IndexH j) {
-    auto idx = i*n + j;
+    auto idx = static_cast<std::size_t>(i)*n + j;
     if (data[idx]) {
       data[idx] = false;
-      history[++index] = idx;
+      history[index++] = idx;
     }
   }
   
@@ -57,12 +73,12 @@ class reduced_compatibility_matrix2 {
   }
 
   void advance() {
-    shots[++shotidx] = index;
+    shots[shotidx++] = index;
   }
   void revert() {
-    int stop = shots[shotidx--];
+    auto stop = shots[--shotidx];
     while (index > stop) {
-			data[history[index--]] = true;
+      data[history[--index]] = true;
     }
   }
 };
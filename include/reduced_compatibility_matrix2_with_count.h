@@ -1,6 +1,7 @@
 #ifndef REDUCED_COMPATIBILITY_MATRIX2_WITH_COUNT_H_
 #define REDUCED_COMPATIBILITY_MATRIX2_WITH_COUNT_H_
 
+#include <cstddef>
 #include <iterator>
 #include <algorithm>
 #include <vector>
@@ -18,39 +19,53 @@ class reduced_compatibility_matrix2_with_count {
   
   std::vector<IndexH> count;
   
-  std::vector</*typename decltype(data)::size_type*/int> history;
-  /*typename decltype(history)::size_type*/ int index;
-  std::vector</*typename decltype(history)::size_type*/int> shots;
-  /*typename decltype(shots)::size_type*/ int shotidx;
+  // history[0..index) are the cells unset along the current path and
+  // shots[0..shotidx) the history sizes at each advance()
+  std::vector<std::size_t> history;
+  std::size_t index;
+  std::vector<std::size_t> shots;
+  std::size_t shotidx;
 
  public:
   reduced_compatibility_matrix2_with_count(IndexG m, IndexH n)
       : m{m},
         n{n},
-        data(m*n),
+        data(static_cast<std::size_t>(m)*n),
         count(m),
-        history(m*n),
-        index{-1},
-        shots(m*n),
-        shotidx{-1} {
+        history(static_cast<std::size_t>(m)*n),
+        index{0},
+        shots(static_cast<std::size_t>(m)+1),
+        shotidx{0} {
+  }
+  
+  // a copy starts with an empty history and cannot revert past this point
+  reduced_compatibility_matrix2_with_count(reduced_compatibility_matrix2_with_count const & other)
+      : m{other.m},
+        n{other.n},
+        data(other.data),
+        count(other.count),
+        history(static_cast<std::size_t>(m)*n),
+        index{0},
+        shots(static_cast<std::size_t>(m)+1),
+        shotidx{0} {
   }
 
   bool get(IndexG i, IndexH j) const {
-    return data[i*n + j];
+    return data[static_cast<std::size_t>(i)*n + j];
   }
   void set(IndexG i, IndexH j) {
-    auto idx = i*n + j;
+    auto idx = static_cast<std::size_t>(i)*n + j;
     if (!data[idx]) {
       data[idx] = true;
       ++count[i];
     }
   }
   void unset(IndexG i, IndexH j) {
-    auto idx = i*n + j;
+    auto idx = static_cast<std::size_t>(i)*n + j;
     if (data[idx]) {
       data[idx] = false;
       --count[i];
-      history[++index] = idx;
+      history[index++] = idx;
     }
   }
   
@@ -64,15 +79,14 @@ class reduced_compatibility_matrix2_with_count {
   }
 
   void advance() {
-    shots[++shotidx] = index;
+    shots[shotidx++] = index;
   }
   void revert() {
-    int stop = shots[shotidx--];
+    auto stop = shots[--shotidx];
     while (index > stop) {
-      auto idx = history[index];
-			data[idx] = true;
-			++count[idx/n];
-      --index;
+      auto idx = history[--index];
+      data[idx] = true;
+      ++count[idx/n];
     }
   }
   
@@ -7,6 +7,8 @@
 #include <algorithm>
 #include <numeric>
 
+#include "embedding_view.h"
+
 template <
     typename G,
     typename H,
@@ -35,7 +37,8 @@ class refined_ri_state_mono {
   std::vector<IndexH> map;
   std::vector<IndexG> inv;
   
-  using H_adjacent_vertices_container_type = typename H::adjacent_vertices_container_type;
+  // every vertex of h, the candidates where a pattern vertex has no parent
+  using H_adjacent_vertices_container_type = std::vector<IndexH>;
   
   H_adjacent_vertices_container_type h_vertices;
   
@@ -127,7 +130,21 @@ class refined_ri_state_mono {
     std::iota(std::begin(h_vertices), std::end(h_vertices), 0);
   }
   
-  refined_ri_state_mono(refined_ri_state_mono const &) = delete;
+ protected:
+  refined_ri_state_mono(refined_ri_state_mono const &) = default;
+  
+ public:
+  refined_ri_state_mono fork() const {
+    return refined_ri_state_mono{*this};
+  }
+
+  embedding_view<IndexG, IndexH> embedding() const {
+    return {map.data(), inv.data(), m, n};
+  }
+
+  IndexG current() const {
+    return *x_it;
+  }
 
   bool empty() {
     return x_it == std::begin(index_order_g);
@@ -301,6 +318,14 @@ class refined_ri_state_ind
         h_out_count(n),
         h_in_count(n) {
   }
+  
+ protected:
+  refined_ri_state_ind(refined_ri_state_ind const &) = default;
+  
+ public:
+  refined_ri_state_ind fork() const {
+    return refined_ri_state_ind{*this};
+  }
  
   bool assign(IndexH y) {
     auto x = *x_it;
@@ -0,0 +1,149 @@
+#ifndef REFINEMENT_H_
+#define REFINEMENT_H_
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Refinement policies for the Ullmann-style states. The state supplies
+// condition(i, j), which says whether (i,j) still has support in M, and
+// dependents(i, j, f), which calls f on every pair whose support may have
+// been (i,j). Removals go through unset() so the policy sees them.
+
+// Rescans the whole matrix until nothing changes; removals are not tracked.
+// With FailFast, refine() gives up as soon as a row runs empty, as the
+// Ullmann states always did; the ullimp states refine to the fixpoint.
+template <
+    typename IndexG,
+    typename IndexH,
+    bool FailFast = true>
+class sweep_refinement {
+ private:
+  IndexG m;
+  IndexH n;
+
+ public:
+  static constexpr bool incremental = false;
+
+  sweep_refinement(IndexG m, IndexH n)
+      : m{m},
+        n{n} {
+  }
+
+  void schedule(IndexG, IndexH) {
+  }
+
+  void schedule_all() {
+  }
+
+  template <
+      typename CompatibilityMatrix,
+      typename Dependents>
+  void unset(CompatibilityMatrix & M, IndexG i, IndexH j, Dependents) {
+    M.unset(i, j);
+  }
+
+  template <
+      typename CompatibilityMatrix,
+      typename Condition,
+      typename Dependents>
+  bool refine(CompatibilityMatrix & M, Condition condition, Dependents) {
+    bool changed;
+    do {
+      changed = false;
+      for (IndexG i=0; i<m; ++i) {
+        for (IndexH j=0; j<n; ++j) {
+          if (M.get(i, j) && !condition(i, j)) {
+            M.unset(i, j);
+            if (FailFast && !M.possible(i)) {
+              return false;
+            }
+            changed = true;
+          }
+        }
+      }
+    } while (changed);
+    return true;
+  }
+};
+
+// AC-3 style: every removal queues the pairs it supported, and refine()
+// rechecks only those until the queue runs dry.
+template <
+    typename IndexG,
+    typename IndexH>
+class worklist_refinement {
+ private:
+  IndexG m;
+  IndexH n;
+
+  std::vector<std::pair<IndexG, IndexH>> queue;
+  std::vector<char> queued;
+
+  void clear() {
+    for (auto const & p : queue) {
+      queued[static_cast<std::size_t>(p.first)*n + p.second] = false;
+    }
+    queue.clear();
+  }
+
+ public:
+  static constexpr bool incremental = true;
+
+  worklist_refinement(IndexG m, IndexH n)
+      : m{m},
+        n{n},
+        queued(static_cast<std::size_t>(m)*n) {
+  }
+
+  void schedule(IndexG i, IndexH j) {
+    auto idx = static_cast<std::size_t>(i)*n + j;
+    if (!queued[idx]) {
+      queued[idx] = true;
+      queue.emplace_back(i, j);
+    }
+  }
+
+  void schedule_all() {
+    for (IndexG i=0; i<m; ++i) {
+      for (IndexH j=0; j<n; ++j) {
+        schedule(i, j);
+      }
+    }
+  }
+
+  template <
+      typename CompatibilityMatrix,
+      typename Dependents>
+  void unset(CompatibilityMatrix & M, IndexG i, IndexH j, Dependents dependents) {
+    if (M.get(i, j)) {
+      M.unset(i, j);
+      dependents(i, j, [this](IndexG ii, IndexH jj) {
+        schedule(ii, jj);
+      });
+    }
+  }
+
+  // false as soon as some row has no candidate left
+  template <
+      typename CompatibilityMatrix,
+      typename Condition,
+      typename Dependents>
+  bool refine(CompatibilityMatrix & M, Condition condition, Dependents dependents) {
+    while (!queue.empty()) {
+      auto p = queue.back();
+      queue.pop_back();
+      queued[static_cast<std::size_t>(p.first)*n + p.second] = false;
+      if (M.get(p.first, p.second) && !condition(p.first, p.second)) {
+        unset(M, p.first, p.second, dependents);
+        if (!M.possible(p.first)) {
+          clear();
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+};
+
+#endif  // REFINEMENT_H_
@@ -7,6 +7,9 @@
 #include <algorithm>
 #include <numeric>
 
+#include "embedding_view.h"
+#include "graph_traits.h"
+
 template <
     typename G,
     typename H,
@@ -36,7 +39,8 @@ class ri2_state_mono {
   std::vector<IndexG> inv;
 
   std::vector<IndexH> h_vertices_vec;  
-  using H_adjacent_vertices_container_type = typename H::adjacent_vertices_container_type;
+  // every vertex of h, the candidates where a pattern vertex has no parent
+  using H_adjacent_vertices_container_type = std::vector<IndexH>;
   H_adjacent_vertices_container_type h_vertices;
   
   bool topology_condition(IndexG u, IndexH v) {
@@ -110,7 +114,21 @@ class ri2_state_mono {
     }*/
   }
   
-  ri2_state_mono(ri2_state_mono const &) = delete;
+ protected:
+  ri2_state_mono(ri2_state_mono const &) = default;
+  
+ public:
+  ri2_state_mono fork() const {
+    return ri2_state_mono{*this};
+  }
+
+  embedding_view<IndexG, IndexH> embedding() const {
+    return {map.data(), inv.data(), m, n};
+  }
+
+  IndexG current() const {
+    return *x_it;
+  }
 
   bool empty() {
     return x_it == std::begin(index_order_g);
@@ -126,14 +144,14 @@ class ri2_state_mono {
   void forget() {
   }
   
-  H_adjacent_vertices_container_type const & candidates() {
+  auto candidates() {
     auto x = *x_it;
     auto parent = g_parents[x].first;
     auto out = g_parents[x].second;
     if (parent != x) {
-      return out ? h.adjacent_vertices(map[parent]) : h.inv_adjacent_vertices(map[parent]);
+      return out ? vertex_range(h.adjacent_vertices(map[parent])) : vertex_range(h.inv_adjacent_vertices(map[parent]));
     } else {
-      return h_vertices;
+      return vertex_range(h_vertices);
     }
   }
 
@@ -235,6 +253,14 @@ class ri2_state_ind
     }
   }
   
+ protected:
+  ri2_state_ind(ri2_state_ind const &) = default;
+  
+ public:
+  ri2_state_ind fork() const {
+    return ri2_state_ind{*this};
+  }
+  
   void push(IndexH y) {
     for (auto j : h.adjacent_vertices(y)) {
       ++h_in_count[j];
@@ -320,6 +346,14 @@ class ri2_state_ind2
       g_in_degree_before[i] = g.in_degree_before(i);
     }
   }
+  
+ protected:
+  ri2_state_ind2(ri2_state_ind2 const &) = default;
+  
+ public:
+  ri2_state_ind2 fork() const {
+    return ri2_state_ind2{*this};
+  }
  
   bool assign(IndexH y) {
     auto x = *x_it;
@@ -8,6 +8,8 @@
 #include <algorithm>
 #include <numeric>
 
+#include "embedding_view.h"
+
 template <
     typename G,
     typename H,
@@ -36,7 +38,8 @@ class ri_dynamic_parent_state_mono {
   std::vector<IndexH> map;
   std::vector<IndexG> inv;
   
-  using H_adjacent_vertices_container_type = typename H::adjacent_vertices_container_type;
+  // every vertex of h, the candidates where a pattern vertex has no parent
+  using H_adjacent_vertices_container_type = std::vector<IndexH>;
   
   H_adjacent_vertices_container_type h_vertices;
   
@@ -78,7 +81,21 @@ class ri_dynamic_parent_state_mono {
     std::iota(std::begin(h_vertices), std::end(h_vertices), 0);
   }
   
-  ri_dynamic_parent_state_mono(ri_dynamic_parent_state_mono const &) = delete;
+ protected:
+  ri_dynamic_parent_state_mono(ri_dynamic_parent_state_mono const &) = default;
+  
+ public:
+  ri_dynamic_parent_state_mono fork() const {
+    return ri_dynamic_parent_state_mono{*this};
+  }
+
+  embedding_view<IndexG, IndexH> embedding() const {
+    return {map.data(), inv.data(), m, n};
+  }
+
+  IndexG current() const {
+    return *x_it;
+  }
 
   bool empty() {
     return x_it == std::begin(index_order_g);
@@ -225,6 +242,14 @@ class ri_dynamic_parent_state_ind
       g_in_count[i] = g.in_degree_before(i);
     }
   }
+  
+ protected:
+  ri_dynamic_parent_state_ind(ri_dynamic_parent_state_ind const &) = default;
+  
+ public:
+  ri_dynamic_parent_state_ind fork() const {
+    return ri_dynamic_parent_state_ind{*this};
+  }
  
   bool assign(IndexH y) {
     auto x = *x_it;
@@ -7,6 +7,9 @@
 #include <algorithm>
 #include <numeric>
 
+#include "embedding_view.h"
+#include "graph_traits.h"
+
 template <
     typename G,
     typename H,
@@ -35,7 +38,8 @@ class ri_lookahead_state_mono {
   std::vector<IndexH> map;
   std::vector<IndexG> inv;
   
-  using H_adjacent_vertices_container_type = typename H::adjacent_vertices_container_type;
+  // every vertex of h, the candidates where a pattern vertex has no parent
+  using H_adjacent_vertices_container_type = std::vector<IndexH>;
   
   H_adjacent_vertices_container_type h_vertices;
   
@@ -214,7 +218,21 @@ class ri_lookahead_state_mono {
     }
   }
   
-  ri_lookahead_state_mono(ri_lookahead_state_mono const &) = delete;
+ protected:
+  ri_lookahead_state_mono(ri_lookahead_state_mono const &) = default;
+  
+ public:
+  ri_lookahead_state_mono fork() const {
+    return ri_lookahead_state_mono{*this};
+  }
+
+  embedding_view<IndexG, IndexH> embedding() const {
+    return {map.data(), inv.data(), m, n};
+  }
+
+  IndexG current() const {
+    return *x_it;
+  }
 
   bool empty() {
     return x_it == std::begin(index_order_g);
@@ -230,14 +248,14 @@ class ri_lookahead_state_mono {
   void forget() {
   }
   
-  H_adjacent_vertices_container_type const & candidates() {
+  auto candidates() {
     auto x = *x_it;
     auto parent = g_parents[x].first;
     auto out = g_parents[x].second;
     if (parent != x) {
-      return out ? h.adjacent_vertices(map[parent]) : h.inv_adjacent_vertices(map[parent]);
+      return out ? vertex_range(h.adjacent_vertices(map[parent])) : vertex_range(h.inv_adjacent_vertices(map[parent]));
     } else {
-      return h_vertices;
+      return vertex_range(h_vertices);
     }
   }
 
@@ -447,6 +465,14 @@ class ri_lookahead_state_ind
  
  public:
   using base::ri_lookahead_state_mono;
+  
+ protected:
+  ri_lookahead_state_ind(ri_lookahead_state_ind const &) = default;
+  
+ public:
+  ri_lookahead_state_ind fork() const {
+    return ri_lookahead_state_ind{*this};
+  }
  
   bool assign(IndexH y) {
     auto x = *x_it;
@@ -7,6 +7,10 @@
 #include <algorithm>
 #include <numeric>
 
+#include "embedding_view.h"
+#include "graph_traits.h"
+#include "scratch_arena.h"
+
 template <
     typename G,
     typename H,
@@ -33,9 +37,10 @@ class ri_state_mono {
   std::vector<std::pair<IndexG,bool>> g_parents;
 
   std::vector<IndexH> map;
-  std::vector<IndexG> inv;
+  scratch_vector<IndexG> inv;
   
-  using H_adjacent_vertices_container_type = typename H::adjacent_vertices_container_type;
+  // every vertex of h, the candidates where a pattern vertex has no parent
+  using H_adjacent_vertices_container_type = scratch_vector<IndexH>;
   
   H_adjacent_vertices_container_type h_vertices;
   
@@ -128,7 +133,21 @@ class ri_state_mono {
     }*/
   }
   
-  ri_state_mono(ri_state_mono const &) = delete;
+ protected:
+  ri_state_mono(ri_state_mono const &) = default;
+  
+ public:
+  ri_state_mono fork() const {
+    return ri_state_mono{*this};
+  }
+
+  embedding_view<IndexG, IndexH> embedding() const {
+    return {map.data(), inv.data(), m, n};
+  }
+
+  IndexG current() const {
+    return *x_it;
+  }
 
   bool empty() {
     return x_it == std::begin(index_order_g);
@@ -144,14 +163,14 @@ class ri_state_mono {
   void forget() {
   }
   
-  H_adjacent_vertices_container_type const & candidates() {
+  auto candidates() {
     auto x = *x_it;
     auto parent = g_parents[x].first;
     auto out = g_parents[x].second;
     if (parent != x) {
-      return out ? h.adjacent_vertices(map[parent]) : h.inv_adjacent_vertices(map[parent]);
+      return out ? vertex_range(h.adjacent_vertices(map[parent])) : vertex_range(h.inv_adjacent_vertices(map[parent]));
     } else {
-      return h_vertices;
+      return vertex_range(h_vertices);
     }
   }
 
@@ -265,6 +284,14 @@ class ri_state_ind
       //g_in_count[i] = g.in_degree_before(i);
     }
   }
+  
+ protected:
+  ri_state_ind(ri_state_ind const &) = default;
+  
+ public:
+  ri_state_ind fork() const {
+    return ri_state_ind{*this};
+  }
  
   bool assign(IndexH y) {
     auto x = *x_it;
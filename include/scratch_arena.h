@@ -0,0 +1,158 @@
+#ifndef SCRATCH_ARENA_H_
+#define SCRATCH_ARENA_H_
+
+#include <cstddef>
+#include <algorithm>
+#include <new>
+#include <vector>
+
+// Storage for the buffers of one query at a time: the initial domain, the
+// compatibility matrices and the target-sized arrays of the states. While
+// a scratch_scope is open on a thread, scratch_vector allocations on that
+// thread are carved out of its arena and freeing them is a no-op; the
+// scope's end rewinds the arena but keeps its memory, so a thread that
+// runs many queries against one target allocates and faults in those
+// buffers once. Without an open scope scratch_vector is a plain vector.
+// Anything allocated inside a scope must be gone when the scope ends.
+class scratch_arena {
+ public:
+  // every allocation starts on a cache line, which bit rows rely on
+  static constexpr std::size_t alignment = 64;
+
+ private:
+  struct block {
+    std::byte * data;
+    std::size_t size;
+  };
+  std::vector<block> blocks;
+  std::size_t current = 0;
+  std::size_t offset = 0;
+  // bytes handed out since the last rewind
+  std::size_t used = 0;
+
+  static std::size_t round_up(std::size_t bytes) {
+    return (bytes + alignment - 1) / alignment * alignment;
+  }
+
+  static block make_block(std::size_t size) {
+    return {static_cast<std::byte *>(::operator new(size, std::align_val_t{alignment})), size};
+  }
+
+  void release_blocks() {
+    for (auto const & b : blocks) {
+      ::operator delete(b.data, std::align_val_t{alignment});
+    }
+    blocks.clear();
+  }
+
+ public:
+  scratch_arena() = default;
+  scratch_arena(scratch_arena const &) = delete;
+  scratch_arena & operator=(scratch_arena const &) = delete;
+
+  ~scratch_arena() {
+    release_blocks();
+  }
+
+  void * allocate(std::size_t bytes) {
+    bytes = round_up(std::max<std::size_t>(bytes, 1));
+    used += bytes;
+    while (current < blocks.size() && offset + bytes > blocks[current].size) {
+      ++current;
+      offset = 0;
+    }
+    if (current == blocks.size()) {
+      auto last = blocks.empty() ? std::size_t{0} : blocks.back().size;
+      blocks.push_back(make_block(std::max({bytes, 2*last, std::size_t{1} << 16})));
+      offset = 0;
+    }
+    auto p = blocks[current].data + offset;
+    offset += bytes;
+    return p;
+  }
+
+  // Makes all memory available again. If the last query did not fit into
+  // the first block, the blocks are merged into one that it would fit.
+  void rewind() {
+    if (blocks.size() > 1 && used > blocks.front().size) {
+      release_blocks();
+      blocks.push_back(make_block(used));
+    }
+    current = 0;
+    offset = 0;
+    used = 0;
+  }
+};
+
+inline scratch_arena *& current_scratch_arena() {
+  thread_local scratch_arena * arena = nullptr;
+  return arena;
+}
+
+// Routes the scratch_vector allocations of this thread to arena until it
+// goes out of scope, then rewinds the arena.
+class scratch_scope {
+ private:
+  scratch_arena & arena;
+  scratch_arena * outer;
+
+ public:
+  explicit scratch_scope(scratch_arena & arena)
+      : arena{arena},
+        outer{current_scratch_arena()} {
+    current_scratch_arena() = &arena;
+  }
+
+  scratch_scope(scratch_scope const &) = delete;
+  scratch_scope & operator=(scratch_scope const &) = delete;
+
+  ~scratch_scope() {
+    current_scratch_arena() = outer;
+    arena.rewind();
+  }
+};
+
+// Takes memory from the arena of the allocating thread if it has an open
+// scratch_scope, from the heap otherwise. A header in front of every
+// allocation records which, so that a buffer may be freed on any thread.
+template <typename T>
+struct scratch_allocator {
+  using value_type = T;
+
+  static constexpr std::size_t header = scratch_arena::alignment;
+
+  scratch_allocator() = default;
+  template <typename U>
+  scratch_allocator(scratch_allocator<U> const &) {
+  }
+
+  T * allocate(std::size_t k) {
+    auto bytes = header + k * sizeof(T);
+    auto arena = current_scratch_arena();
+    auto p = static_cast<std::byte *>(arena != nullptr
+        ? arena->allocate(bytes)
+        : ::operator new(bytes, std::align_val_t{scratch_arena::alignment}));
+    *reinterpret_cast<scratch_arena **>(p) = arena;
+    return reinterpret_cast<T *>(p + header);
+  }
+  void deallocate(T * p, std::size_t) {
+    auto q = reinterpret_cast<std::byte *>(p) - header;
+    if (*reinterpret_cast<scratch_arena **>(q) == nullptr) {
+      ::operator delete(q, std::align_val_t{scratch_arena::alignment});
+    }
+  }
+
+  template <typename U>
+  bool operator==(scratch_allocator<U> const &) const {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(scratch_allocator<U> const &) const {
+    return false;
+  }
+};
+
+template <typename T>
+using scratch_vector = std::vector<T, scratch_allocator<T>>;
+
+#endif  // SCRATCH_ARENA_H_
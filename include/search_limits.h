@@ -0,0 +1,160 @@
+#ifndef SEARCH_LIMITS_H_
+#define SEARCH_LIMITS_H_
+
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+
+enum class search_limit {
+  none,
+  deadline,
+  nodes,
+  solutions,
+  cancelled
+};
+
+inline char const * to_string(search_limit limit) {
+  switch (limit) {
+    case search_limit::deadline: return "deadline";
+    case search_limit::nodes: return "nodes";
+    case search_limit::solutions: return "solutions";
+    case search_limit::cancelled: return "cancelled";
+    default: return "none";
+  }
+}
+
+// Bounds on one search, shared by all of its workers. Set the bounds
+// before the search starts; cancel may be set from any thread at any
+// time. Afterwards hit() tells which bound stopped the search, if any.
+// An object serves a single search.
+class search_limits {
+ public:
+  using clock = std::chrono::steady_clock;
+
+  clock::time_point deadline = clock::time_point::max();
+  std::uint64_t max_nodes = std::numeric_limits<std::uint64_t>::max();
+  std::uint64_t max_solutions = std::numeric_limits<std::uint64_t>::max();
+  std::atomic<bool> cancel{false};
+
+  // nodes a worker visits between two looks at the clock and the shared
+  // counters
+  std::uint64_t check_interval = 1024;
+
+ private:
+  friend class limit_checker;
+
+  std::atomic<std::uint64_t> nodes{0};
+  std::atomic<std::uint64_t> solutions{0};
+  std::atomic<search_limit> hit_{search_limit::none};
+
+  void stop(search_limit limit) {
+    auto expected = search_limit::none;
+    hit_.compare_exchange_strong(expected, limit);
+  }
+
+ public:
+  search_limits() = default;
+
+  search_limits & within(clock::duration d) {
+    deadline = clock::now() + d;
+    return *this;
+  }
+
+  search_limit hit() const {
+    return hit_.load(std::memory_order_relaxed);
+  }
+};
+
+// One worker's view of a search_limits, or of none at all. A worker
+// reserves nodes from the shared budget, check_interval at a time (fewer
+// when max_nodes is near), and looks at the deadline and the cancel flag
+// whenever it reserves. Reservations never add up to more than max_nodes,
+// so no search visits more than max_nodes nodes. It can stop short of it:
+// nodes reserved by a worker that is still busy are not available to the
+// others, so up to check_interval nodes per other worker may be left over
+// when the nodes limit is hit. Workers hand back what they did not use
+// when they run out of work. Solutions are counted exactly.
+class limit_checker {
+ private:
+  search_limits * limits;
+  std::uint64_t pending = 0;
+  std::uint64_t budget = 0;
+
+  // takes up to check_interval nodes from what is left of max_nodes
+  std::uint64_t reserve() {
+    auto total = limits->nodes.load(std::memory_order_relaxed);
+    std::uint64_t chunk;
+    do {
+      chunk = std::min(limits->check_interval, limits->max_nodes - std::min(total, limits->max_nodes));
+    } while (chunk > 0 && !limits->nodes.compare_exchange_weak(total, total + chunk, std::memory_order_relaxed));
+    return chunk;
+  }
+
+  bool settle() {
+    pending = 0;
+    budget = 0;
+    if (limits->cancel.load(std::memory_order_relaxed)) {
+      limits->stop(search_limit::cancelled);
+    } else if (limits->deadline != search_limits::clock::time_point::max() &&
+        search_limits::clock::now() >= limits->deadline) {
+      limits->stop(search_limit::deadline);
+    } else if (limits->hit() == search_limit::none) {
+      budget = reserve();
+      if (budget == 0) {
+        limits->stop(search_limit::nodes);
+      }
+    }
+    pending = budget > 0;
+    return limits->hit() == search_limit::none;
+  }
+
+ public:
+  explicit limit_checker(search_limits * limits)
+      : limits{limits} {
+  }
+
+  limit_checker(limit_checker const &) = delete;
+  limit_checker & operator=(limit_checker const &) = delete;
+
+  ~limit_checker() {
+    release();
+  }
+
+  // false once the search has to stop; a limit hit by another worker is
+  // only noticed at the next settlement
+  bool node() {
+    return limits == nullptr || ++pending <= budget || settle();
+  }
+
+  // hands the unused part of the reservation back to the other workers
+  void release() {
+    if (limits != nullptr && pending < budget) {
+      limits->nodes.fetch_sub(budget - pending, std::memory_order_relaxed);
+      budget = pending;
+    }
+  }
+
+  // false if this solution is beyond max_solutions and must not be reported
+  bool solution() {
+    if (limits == nullptr) {
+      return true;
+    }
+    auto k = limits->solutions.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (k >= limits->max_solutions) {
+      limits->stop(search_limit::solutions);
+    }
+    return k <= limits->max_solutions;
+  }
+
+  bool stopped() const {
+    return limits != nullptr && limits->hit() != search_limit::none;
+  }
+
+  search_limit hit() const {
+    return limits != nullptr ? limits->hit() : search_limit::none;
+  }
+};
+
+#endif  // SEARCH_LIMITS_H_
@@ -0,0 +1,159 @@
+#ifndef SEARCH_STATISTICS_H_
+#define SEARCH_STATISTICS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <numeric>
+#include <ostream>
+#include <vector>
+
+#include "search_limits.h"
+
+enum class search_phase {
+  prepare,
+  assign,
+  push,
+  pop
+};
+
+struct search_statistics {
+  std::vector<std::uint64_t> nodes_per_depth;
+  std::uint64_t candidates = 0;
+  std::uint64_t assign_failures = 0;
+  std::uint64_t pushes = 0;
+  std::uint64_t solutions = 0;
+  std::chrono::nanoseconds prepare_time{0};
+  std::chrono::nanoseconds assign_time{0};
+  std::chrono::nanoseconds push_time{0};
+  std::chrono::nanoseconds pop_time{0};
+  // the limit that stopped the search, if any
+  search_limit limit = search_limit::none;
+
+  std::uint64_t nodes() const {
+    return std::accumulate(std::begin(nodes_per_depth), std::end(nodes_per_depth), std::uint64_t{0});
+  }
+
+  search_statistics & operator+=(search_statistics const & other) {
+    if (nodes_per_depth.size() < other.nodes_per_depth.size()) {
+      nodes_per_depth.resize(other.nodes_per_depth.size());
+    }
+    for (std::size_t d=0; d<other.nodes_per_depth.size(); ++d) {
+      nodes_per_depth[d] += other.nodes_per_depth[d];
+    }
+    candidates += other.candidates;
+    assign_failures += other.assign_failures;
+    pushes += other.pushes;
+    solutions += other.solutions;
+    prepare_time += other.prepare_time;
+    assign_time += other.assign_time;
+    push_time += other.push_time;
+    pop_time += other.pop_time;
+    if (limit == search_limit::none) {
+      limit = other.limit;
+    }
+    return *this;
+  }
+};
+
+inline std::ostream & write_json(std::ostream & out, search_statistics const & s) {
+  out << "{\"nodes\":" << s.nodes() << ",\"nodes_per_depth\":[";
+  for (std::size_t d=0; d<s.nodes_per_depth.size(); ++d) {
+    out << (d ? "," : "") << s.nodes_per_depth[d];
+  }
+  return out << "]"
+      << ",\"candidates\":" << s.candidates
+      << ",\"assign_failures\":" << s.assign_failures
+      << ",\"pushes\":" << s.pushes
+      << ",\"solutions\":" << s.solutions
+      << ",\"prepare_ns\":" << s.prepare_time.count()
+      << ",\"assign_ns\":" << s.assign_time.count()
+      << ",\"push_ns\":" << s.push_time.count()
+      << ",\"pop_ns\":" << s.pop_time.count()
+      << ",\"limit\":\"" << to_string(s.limit) << "\""
+      << "}";
+}
+
+// Statistics policies for explore() and parallel_explore(). Every worker
+// owns one instance, so nothing is shared while searching; the reports are
+// summed afterwards.
+
+// Records nothing; every hook compiles away and report() is empty.
+class no_statistics {
+ public:
+  void node(std::size_t) {
+  }
+  void candidate() {
+  }
+  void assign_failure() {
+  }
+  void push() {
+  }
+  void solution() {
+  }
+
+  template <
+      search_phase Phase,
+      typename F>
+  decltype(auto) timed(F && f) {
+    return f();
+  }
+
+  search_statistics report() const {
+    return {};
+  }
+};
+
+class collect_statistics {
+ private:
+  search_statistics stats;
+
+  std::chrono::nanoseconds & time_of(search_phase phase) {
+    switch (phase) {
+      case search_phase::prepare: return stats.prepare_time;
+      case search_phase::assign: return stats.assign_time;
+      case search_phase::push: return stats.push_time;
+      default: return stats.pop_time;
+    }
+  }
+
+ public:
+  void node(std::size_t depth) {
+    if (stats.nodes_per_depth.size() <= depth) {
+      stats.nodes_per_depth.resize(depth+1);
+    }
+    ++stats.nodes_per_depth[depth];
+  }
+  void candidate() {
+    ++stats.candidates;
+  }
+  void assign_failure() {
+    ++stats.assign_failures;
+  }
+  void push() {
+    ++stats.pushes;
+  }
+  void solution() {
+    ++stats.solutions;
+  }
+
+  template <
+      search_phase Phase,
+      typename F>
+  decltype(auto) timed(F && f) {
+    struct timer {
+      std::chrono::nanoseconds & total;
+      std::chrono::steady_clock::time_point start;
+      ~timer() {
+        total += std::chrono::steady_clock::now() - start;
+      }
+    } t{time_of(Phase), std::chrono::steady_clock::now()};
+    return f();
+  }
+
+  search_statistics const & report() const {
+    return stats;
+  }
+};
+
+#endif  // SEARCH_STATISTICS_H_
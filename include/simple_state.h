@@ -9,6 +9,8 @@
 #include <boost/range/iterator_range.hpp>
 #include <boost/range/adaptor/filtered.hpp>
 
+#include "embedding_view.h"
+
 template <
     typename G,
     typename H,
@@ -74,7 +76,21 @@ class simple_state_mono {
         inv(n, m) {
   }
   
-  simple_state_mono(simple_state_mono const &) = delete;
+ protected:
+  simple_state_mono(simple_state_mono const &) = default;
+  
+ public:
+  simple_state_mono fork() const {
+    return simple_state_mono{*this};
+  }
+
+  embedding_view<IndexG, IndexH> embedding() const {
+    return {map.data(), inv.data(), m, n};
+  }
+
+  IndexG current() const {
+    return *x_it;
+  }
 
   bool empty() {
     return x_it == std::begin(index_order_g);
@@ -201,6 +217,14 @@ class simple_state_ind
       });
     }
   }
+  
+ protected:
+  simple_state_ind(simple_state_ind const &) = default;
+  
+ public:
+  simple_state_ind fork() const {
+    return simple_state_ind{*this};
+  }
 
   bool assign(IndexH y) {
     auto x = *x_it;
@@ -266,6 +290,14 @@ class simple_state_ind2
  
  public:
   using base::simple_state_mono;
+  
+ protected:
+  simple_state_ind2(simple_state_ind2 const &) = default;
+  
+ public:
+  simple_state_ind2 fork() const {
+    return simple_state_ind2{*this};
+  }
  
   bool assign(IndexH y) {
     if (!base::assign(y)) {
@@ -334,7 +366,7 @@ class simple_state_ind3
  
   bool relative_degree_condition(IndexG u, IndexH v) {
     auto const & v_adj = h.adjacent_vertices(v);
-    auto count_h = std::count_if(std::begin(v_adj), std::end(v_adj), [this](auto j) {
+    IndexG count_h = std::count_if(std::begin(v_adj), std::end(v_adj), [this](auto j) {
       return inv[j] != m;
     });
     if (g_out_count[u] != count_h) {
@@ -379,6 +411,14 @@ class simple_state_ind3
       });
     }
   }
+  
+ protected:
+  simple_state_ind3(simple_state_ind3 const &) = default;
+  
+ public:
+  simple_state_ind3 fork() const {
+    return simple_state_ind3{*this};
+  }
  
   bool assign(IndexH y) {
     auto x = *x_it;
@@ -0,0 +1,39 @@
+#ifndef SOLUTION_COUNTER_H_
+#define SOLUTION_COUNTER_H_
+
+#include <cstdint>
+#include <atomic>
+
+// Every copy counts locally and adds its count to the shared total when it
+// is destroyed, so each worker of parallel_explore reduces without contention.
+template <typename Count = std::uint64_t>
+class solution_counter {
+ private:
+  std::atomic<Count> * total;
+  Count count;
+  
+ public:
+  explicit solution_counter(std::atomic<Count> & total)
+      : total{&total},
+        count{0} {
+  }
+  
+  solution_counter(solution_counter const & other)
+      : total{other.total},
+        count{0} {
+  }
+  
+  solution_counter & operator=(solution_counter const &) = delete;
+  
+  ~solution_counter() {
+    total->fetch_add(count, std::memory_order_relaxed);
+  }
+  
+  template <typename Embedding>
+  bool operator()(Embedding const &) {
+    ++count;
+    return true;
+  }
+};
+
+#endif  // SOLUTION_COUNTER_H_
@@ -0,0 +1,94 @@
+#ifndef SPARSE_ADJACENCY_LISTMAT_H_
+#define SPARSE_ADJACENCY_LISTMAT_H_
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "graph_traits.h"
+#include "bit_row.h"
+#include "csr_adjacency_list.h"
+
+// Drop-in for adjacency_listmat on large sparse targets. The neighbour
+// lists are the sorted rows of a csr_adjacency_list. Instead of an n*n
+// bitmap, edge(u,v) tests a bitmap row only for hubs, vertices whose out
+// row is at least as long as a bitmap row, and otherwise binary searches
+// the shorter of the out row of u and the in row of v. Both kinds of row
+// are bounded by the out degree, so memory stays O(n+e).
+template <typename Index>
+class sparse_adjacency_listmat {
+ public:
+  using directed_category = bidirectional_tag;
+
+  using index_type = Index;
+  using adjacent_vertices_container_type = typename csr_adjacency_list<Index>::adjacent_vertices_container_type;
+
+ private:
+  static constexpr std::size_t no_hub = std::numeric_limits<std::size_t>::max();
+
+  index_type n;
+
+  csr_adjacency_list<index_type> lists;
+
+  // offset of the bitmap row of u in hub_rows, or no_hub
+  std::vector<std::size_t> hub;
+
+  std::size_t stride;
+  bit_row_vector hub_rows;
+
+ public:
+  template <typename G>
+  explicit sparse_adjacency_listmat(G const & g)
+      : n{g.num_vertices()},
+        lists{g},
+        hub(n, no_hub),
+        stride{bit_row_words(n)} {
+    std::size_t num_hubs = 0;
+    for (index_type u=0; u<n; ++u) {
+      if (lists.out_degree(u) >= stride) {
+        hub[u] = num_hubs++ * stride;
+      }
+    }
+    hub_rows.resize(num_hubs * stride);
+    for (index_type u=0; u<n; ++u) {
+      if (hub[u] != no_hub) {
+        for (auto v : lists.adjacent_vertices(u)) {
+          hub_rows[hub[u] + v/bit_word_bits] |= static_cast<bit_word>(1) << (v % bit_word_bits);
+        }
+      }
+    }
+  }
+
+  index_type num_vertices() const {
+    return n;
+  }
+
+  bool edge(index_type u, index_type v) const {
+    if (hub[u] != no_hub) {
+      return bit_row_test(hub_rows.data() + hub[u], v);
+    }
+    return lists.edge(u, v);
+  }
+
+  index_type out_degree(index_type u) const {
+    return lists.out_degree(u);
+  }
+
+  index_type in_degree(index_type u) const {
+    return lists.in_degree(u);
+  }
+
+  index_type degree(index_type u) const {
+    return out_degree(u) + in_degree(u);
+  }
+
+  adjacent_vertices_container_type adjacent_vertices(index_type u) const {
+    return lists.adjacent_vertices(u);
+  }
+
+  adjacent_vertices_container_type inv_adjacent_vertices(index_type u) const {
+    return lists.inv_adjacent_vertices(u);
+  }
+};
+
+#endif  // SPARSE_ADJACENCY_LISTMAT_H_
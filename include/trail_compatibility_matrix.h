@@ -0,0 +1,89 @@
+#ifndef TRAIL_COMPATIBILITY_MATRIX_H_
+#define TRAIL_COMPATIBILITY_MATRIX_H_
+
+#include <vector>
+
+#include "scratch_arena.h"
+
+// Keeps a single m*n frame and logs every flipped cell, so revert() undoes
+// both set() and unset() since the matching advance(). Changes made before
+// the first advance() cannot be reverted and are not logged.
+template <
+    typename IndexG,
+    typename IndexH>
+class trail_compatibility_matrix {
+ private:
+  IndexG const m;
+  IndexH const n;
+
+  scratch_vector<char> data;
+
+  std::vector<typename decltype(data)::size_type> trail;
+  std::vector<typename decltype(trail)::size_type> shots;
+
+  typename decltype(data)::size_type pos(IndexG i, IndexH j) const {
+    return static_cast<typename decltype(data)::size_type>(i)*n + j;
+  }
+
+ public:
+  trail_compatibility_matrix(IndexG m, IndexH n)
+      : m{m},
+        n{n},
+        data(static_cast<typename decltype(data)::size_type>(m)*n) {
+    shots.reserve(m+1);
+  }
+
+  // a copy starts with an empty trail and cannot revert past this point
+  trail_compatibility_matrix(trail_compatibility_matrix const & other)
+      : m{other.m},
+        n{other.n},
+        data(other.data) {
+    shots.reserve(m+1);
+  }
+
+  bool get(IndexG i, IndexH j) const {
+    return data[pos(i, j)];
+  }
+  void set(IndexG i, IndexH j) {
+    auto idx = pos(i, j);
+    if (!data[idx]) {
+      data[idx] = true;
+      if (!shots.empty()) {
+        trail.push_back(idx);
+      }
+    }
+  }
+  void unset(IndexG i, IndexH j) {
+    auto idx = pos(i, j);
+    if (data[idx]) {
+      data[idx] = false;
+      if (!shots.empty()) {
+        trail.push_back(idx);
+      }
+    }
+  }
+
+  bool possible(IndexG i) const {
+    for (IndexH j=0; j<n; ++j) {
+      if (get(i, j)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void advance() {
+    shots.push_back(trail.size());
+  }
+  void revert() {
+    auto size = shots.back();
+    shots.pop_back();
+    while (trail.size() > size) {
+      auto idx = trail.back();
+      data[idx] = !data[idx];
+      trail.pop_back();
+    }
+  }
+};
+
+#endif  // TRAIL_COMPATIBILITY_MATRIX_H_
@@ -8,6 +8,9 @@
 #include <boost/range/iterator_range.hpp>
 #include <boost/range/adaptor/filtered.hpp>
 
+#include "embedding_view.h"
+#include "initial_candidates.h"
+
 template <
     typename G,
     typename H,
@@ -34,6 +37,9 @@ class ullimp2_state_base {
   IndexOrderG const & index_order_g;
   x_it_type x_it;
 
+  std::vector<IndexH> map;
+  std::vector<IndexG> inv;
+
   CompatibilityMatrix M;
 
  public:
@@ -51,19 +57,27 @@ class ullimp2_state_base {
         edge_comp{edge_comp},
         index_order_g{index_order_g},
         x_it{std::begin(index_order_g)},
+        map(m, n),
+        inv(n, m),
         M(m, n) {
     for (IndexG i=0; i<m; ++i) {
-      for (IndexH j=0; j<n; ++j) {
-        if (vertex_comp(i, j) &&
-            g.out_degree(i) <= h.out_degree(j) &&
-            g.in_degree(i) <= h.in_degree(j)) {
-          M.set(i, j);
-        }
-      }
+      for_each_initial_candidate(g, h, vertex_comp, i, [this, i](IndexH j) {
+        M.set(i, j);
+      });
     }
   }
   
-  ullimp2_state_base(ullimp2_state_base const &) = delete;
+ protected:
+  ullimp2_state_base(ullimp2_state_base const &) = default;
+  
+ public:
+  embedding_view<IndexG, IndexH> embedding() const {
+    return {map.data(), inv.data(), m, n};
+  }
+
+  IndexG current() const {
+    return *x_it;
+  }
 
   bool empty() const {
     return x_it == std::begin(index_order_g);
@@ -96,11 +110,17 @@ class ullimp2_state_base {
   }
 
   void push(IndexH y) {
+    auto x = *x_it;
+    map[x] = y;
+    inv[y] = x;
     ++x_it;
   }
   
   void pop() {
     --x_it;
+    auto x = *x_it;
+    inv[map[x]] = m;
+    map[x] = n;
   }
 };
 
@@ -176,6 +196,14 @@ class ullimp2_state_ind
             IndexOrderG>(g, h, vertex_comp, edge_comp, index_order_g) {
   }
   
+ protected:
+  ullimp2_state_ind(ullimp2_state_ind const &) = default;
+  
+ public:
+  ullimp2_state_ind fork() const {
+    return ullimp2_state_ind{*this};
+  }
+  
   bool assign(IndexH y) {
     return true;
   }
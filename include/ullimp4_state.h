@@ -6,6 +6,9 @@
 #include <stack>
 #include <set>
 
+#include "embedding_view.h"
+#include "initial_candidates.h"
+
 template <
     typename G,
     typename H,
@@ -34,7 +37,7 @@ class ullimp4_state_base {
   std::vector<std::set<IndexH>> M;
   std::vector<std::stack<std::pair<IndexG,IndexH>>> changes;
   
-  std::vector<IndexG> map;
+  std::vector<IndexH> map;
   std::vector<IndexG> inv;
 
  public:
@@ -57,17 +60,23 @@ class ullimp4_state_base {
         map(m, n),
         inv(n, m) {
     for (IndexG i=0; i<m; ++i) {
-      for (IndexH j=0; j<n; ++j) {
-        if (vertex_comp(i, j) &&
-            g.out_degree(i) <= h.out_degree(j) &&
-            g.in_degree(i) <= h.in_degree(j)) {
-          M[i].insert(j);
-        }
-      }
+      for_each_initial_candidate(g, h, vertex_comp, i, [this, i](IndexH j) {
+        M[i].insert(j);
+      });
     }
   }
   
-  ullimp4_state_base(ullimp4_state_base const &) = delete;
+ protected:
+  ullimp4_state_base(ullimp4_state_base const &) = default;
+  
+ public:
+  embedding_view<IndexG, IndexH> embedding() const {
+    return {map.data(), inv.data(), m, n};
+  }
+
+  IndexG current() const {
+    return *x_it;
+  }
 
   bool empty() const {
     return x_it == std::begin(index_order_g);
@@ -199,6 +208,14 @@ class ullimp4_state_mono
             IndexOrderG>(g, h, vertex_comp, edge_comp, index_order_g) {
   }
   
+ protected:
+  ullimp4_state_mono(ullimp4_state_mono const &) = default;
+  
+ public:
+  ullimp4_state_mono fork() const {
+    return ullimp4_state_mono{*this};
+  }
+  
   bool assign(IndexH y) {
     return true;
   }
@@ -279,6 +296,14 @@ class ullimp4_state_ind
         h_in_degree_mapped(n) {
   }
   
+ protected:
+  ullimp4_state_ind(ullimp4_state_ind const &) = default;
+  
+ public:
+  ullimp4_state_ind fork() const {
+    return ullimp4_state_ind{*this};
+  }
+  
   bool assign(IndexH y) {
     auto x = *x_it;
     return
@@ -360,6 +385,14 @@ class ullimp4_state_ind2
             IndexOrderG>(g, h, vertex_comp, edge_comp, index_order_g) {
   }
   
+ protected:
+  ullimp4_state_ind2(ullimp4_state_ind2 const &) = default;
+  
+ public:
+  ullimp4_state_ind2 fork() const {
+    return ullimp4_state_ind2{*this};
+  }
+  
   bool assign(IndexH y) {
     auto x = *x_it;
     IndexH h_out_degree_before_y = 0;
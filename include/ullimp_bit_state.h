@@ -0,0 +1,312 @@
+#ifndef ULLIMP_BIT_STATE_H_
+#define ULLIMP_BIT_STATE_H_
+
+#include <iterator>
+#include <vector>
+
+#include <boost/range/iterator_range.hpp>
+
+#include "embedding_view.h"
+#include "bit_row.h"
+#include "bit_adjacency.h"
+#include "bit_ullmann_refiner.h"
+#include "initial_candidates.h"
+
+template <
+    typename G,
+    typename H,
+    typename VertexEquivalencePredicate,
+    typename EdgeEquivalencePredicate,
+    typename CompatibilityMatrix,
+    typename IndexOrderG>
+class ullimp_bit_state_base {
+ protected:
+  using IndexG = typename G::index_type;
+  using IndexH = typename H::index_type;
+
+  IndexG m;
+  IndexH n;
+
+  G const & g;
+  H const & h;
+
+  VertexEquivalencePredicate vertex_comp;
+  EdgeEquivalencePredicate edge_comp;
+
+  CompatibilityMatrix M;
+  bit_ullmann_refiner<G, H> R;
+
+  IndexOrderG const & index_order_g;
+  typename IndexOrderG::const_iterator x_it;
+
+  std::vector<IndexH> map;
+  std::vector<IndexG> inv;
+
+  bool restrict(IndexG i, bit_word const * mask) {
+    if (M.and_row(i, mask)) {
+      if (!M.possible(i)) {
+        return false;
+      }
+      R.touch(i);
+    }
+    return true;
+  }
+
+  bool exclude(IndexG i, bit_word const * mask) {
+    if (M.andnot_row(i, mask)) {
+      if (!M.possible(i)) {
+        return false;
+      }
+      R.touch(i);
+    }
+    return true;
+  }
+
+  bool filter(IndexG x, IndexH y) {
+    for (IndexG i=0; i<m; ++i) {
+      if (i != x && M.get(i, y)) {
+        M.unset(i, y);
+        if (!M.possible(i)) {
+          return false;
+        }
+        R.touch(i);
+      }
+    }
+    if (M.keep_only(x, y)) {
+      R.touch(x);
+    }
+    return true;
+  }
+
+ public:
+  ullimp_bit_state_base(
+      G const & g,
+      H const & h,
+      bit_adjacency<IndexH> const & a,
+      VertexEquivalencePredicate const & vertex_comp,
+      EdgeEquivalencePredicate const & edge_comp,
+      IndexOrderG const & index_order_g)
+      : m{g.num_vertices()},
+        n{h.num_vertices()},
+        g{g},
+        h{h},
+        vertex_comp{vertex_comp},
+        edge_comp{edge_comp},
+        M(m, n),
+        R(g, a),
+        index_order_g{index_order_g},
+        x_it{std::begin(index_order_g)},
+        map(m, n),
+        inv(n, m) {
+    for (IndexG i=0; i<m; ++i) {
+      for_each_initial_candidate(g, h, vertex_comp, i, [this, i](IndexH j) {
+        M.set(i, j);
+      });
+    }
+    R.touch_all();
+    R.refine(M);
+  }
+
+ protected:
+  ullimp_bit_state_base(ullimp_bit_state_base const &) = default;
+
+ public:
+  embedding_view<IndexG, IndexH> embedding() const {
+    return {map.data(), inv.data(), m, n};
+  }
+
+  IndexG current() const {
+    return *x_it;
+  }
+
+  bool empty() {
+    return x_it == std::begin(index_order_g);
+  }
+
+  bool full() {
+    return x_it == std::end(index_order_g);
+  }
+
+  void prepare() {
+  }
+
+  void forget() {
+  }
+
+  auto candidates() {
+    auto x = *x_it;
+    return boost::make_iterator_range(
+        M.row_begin(x),
+        M.row_end(x));
+  }
+
+  void advance() {
+    M.advance();
+  }
+
+  void revert() {
+    M.revert();
+  }
+
+  void push(IndexH y) {
+    auto x = *x_it;
+    map[x] = y;
+    inv[y] = x;
+    ++x_it;
+  }
+
+  void pop() {
+    --x_it;
+    auto x = *x_it;
+    inv[map[x]] = m;
+    map[x] = n;
+  }
+};
+
+template <
+    typename G,
+    typename H,
+    typename VertexEquivalencePredicate,
+    typename EdgeEquivalencePredicate,
+    typename CompatibilityMatrix,
+    typename IndexOrderG>
+class ullimp_bit_state_mono
+  : public ullimp_bit_state_base<
+        G,
+        H,
+        VertexEquivalencePredicate,
+        EdgeEquivalencePredicate,
+        CompatibilityMatrix,
+        IndexOrderG> {
+ private:
+  using base = ullimp_bit_state_base<
+      G,
+      H,
+      VertexEquivalencePredicate,
+      EdgeEquivalencePredicate,
+      CompatibilityMatrix,
+      IndexOrderG>;
+
+ protected:
+  using IndexG = typename base::IndexG;
+  using IndexH = typename base::IndexH;
+
+  using base::g;
+  using base::M;
+  using base::R;
+  using base::x_it;
+  using base::filter;
+  using base::restrict;
+
+  bool neighborhood_filter(IndexG x, IndexH y) {
+    for (auto i : g.adjacent_vertices(x)) {
+      if (!restrict(i, R.out_row(y))) {
+        return false;
+      }
+    }
+    for (auto i : g.inv_adjacent_vertices(x)) {
+      if (!restrict(i, R.in_row(y))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ public:
+  using base::base;
+
+ protected:
+  ullimp_bit_state_mono(ullimp_bit_state_mono const &) = default;
+
+ public:
+  ullimp_bit_state_mono fork() const {
+    return ullimp_bit_state_mono{*this};
+  }
+
+  bool assign(IndexH y) {
+    auto x = *x_it;
+    if (!filter(x, y) || !neighborhood_filter(x, y)) {
+      R.clear();
+      return false;
+    }
+    return R.refine(M);
+  }
+};
+
+template <
+    typename G,
+    typename H,
+    typename VertexEquivalencePredicate,
+    typename EdgeEquivalencePredicate,
+    typename CompatibilityMatrix,
+    typename IndexOrderG>
+class ullimp_bit_state_ind
+  : public ullimp_bit_state_base<
+        G,
+        H,
+        VertexEquivalencePredicate,
+        EdgeEquivalencePredicate,
+        CompatibilityMatrix,
+        IndexOrderG> {
+ private:
+  using base = ullimp_bit_state_base<
+      G,
+      H,
+      VertexEquivalencePredicate,
+      EdgeEquivalencePredicate,
+      CompatibilityMatrix,
+      IndexOrderG>;
+
+ protected:
+  using IndexG = typename base::IndexG;
+  using IndexH = typename base::IndexH;
+
+  using base::m;
+  using base::g;
+  using base::M;
+  using base::R;
+  using base::x_it;
+  using base::filter;
+  using base::restrict;
+  using base::exclude;
+
+  bool neighborhood_filter(IndexG x, IndexH y) {
+    for (IndexG i=0; i<m; ++i) {
+      if (i == x) {
+        continue;
+      }
+      if (!(g.edge(x, i) ? restrict(i, R.out_row(y)) : exclude(i, R.out_row(y)))) {
+        return false;
+      }
+      if (!(g.edge(i, x) ? restrict(i, R.in_row(y)) : exclude(i, R.in_row(y)))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ public:
+  using base::base;
+
+ protected:
+  ullimp_bit_state_ind(ullimp_bit_state_ind const &) = default;
+
+ public:
+  ullimp_bit_state_ind fork() const {
+    return ullimp_bit_state_ind{*this};
+  }
+
+  bool assign(IndexH y) {
+    auto x = *x_it;
+    if (g.edge(x, x) != bit_row_test(R.out_row(y), y)) {
+      return false;
+    }
+    if (!filter(x, y) || !neighborhood_filter(x, y)) {
+      R.clear();
+      return false;
+    }
+    return R.refine(M);
+  }
+};
+
+#endif  // ULLIMP_BIT_STATE_H_
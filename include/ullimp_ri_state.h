@@ -7,13 +7,18 @@
 #include <algorithm>
 #include <numeric>
 
+#include "embedding_view.h"
+#include "graph_traits.h"
+#include "initial_candidates.h"
+
 template <
     typename G,
     typename H,
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate,
     typename CompatibilityMatrix,
-    typename IndexOrderG>
+    typename IndexOrderG,
+    typename Refinement>
 class ullimp_ri_state_mono {
  protected:
   using IndexG = typename G::index_type;
@@ -36,11 +41,14 @@ class ullimp_ri_state_mono {
   std::vector<IndexH> map;
   std::vector<IndexG> inv;
   
-  using H_adjacent_vertices_container_type = typename H::adjacent_vertices_container_type;
+  // every vertex of h, the candidates where a pattern vertex has no parent
+  using H_adjacent_vertices_container_type = std::vector<IndexH>;
   
   H_adjacent_vertices_container_type h_vertices;
 
   CompatibilityMatrix M;
+  Refinement R;
+  bool consistent;
   
   std::vector<IndexG> index_pos_g;
   
@@ -51,14 +59,14 @@ class ullimp_ri_state_mono {
     for (auto i : g.adjacent_vertices_after(u)) {
       for (auto j : h.not_adjacent_vertices(v)) {
         if (inv[j] == m) {
-          M.unset(i, j);
+          remove(i, j);
         }
       }
     }
     for (auto i : g.inv_adjacent_vertices_after(u)) {
       for (auto j : h.not_inv_adjacent_vertices(v)) {
         if (inv[j] == m) {
-          M.unset(i, j);
+          remove(i, j);
         }
       }
     }
@@ -92,19 +100,49 @@ class ullimp_ri_state_mono {
     return true;
   }
   
-  void refine() {
-    bool changed;
-    do {
-      changed = false;
-      for (IndexG u=0; u<m; ++u) {
-        for (IndexH v=0; v<n; ++v) {
-          if (M.get(u, v) && !ullmann_condition(u, v)) {
-            M.unset(u, v);
-            changed = true;
-          }
+  // pairs (i,j) that may have used (u,v) as support
+  template <typename F>
+  void dependents(IndexG u, IndexH v, F f) {
+    for (auto i : g.inv_adjacent_vertices(u)) {
+      for (auto j : h.inv_adjacent_vertices(v)) {
+        if (M.get(i, j)) {
+          f(i, j);
+        }
+      }
+    }
+    for (auto i : g.adjacent_vertices(u)) {
+      for (auto j : h.adjacent_vertices(v)) {
+        if (M.get(i, j)) {
+          f(i, j);
         }
       }
-    } while(changed);
+    }
+  }
+  
+  void remove(IndexG u, IndexH v) {
+    R.unset(M, u, v, [this](IndexG i, IndexH j, auto f) {dependents(i, j, f);});
+  }
+  
+  bool refine() {
+    return R.refine(
+        M,
+        [this](IndexG u, IndexH v) {return ullmann_condition(u, v);},
+        [this](IndexG u, IndexH v, auto f) {dependents(u, v, f);});
+  }
+  
+  // reduce row u and column v to the assignment and propagate to a fixpoint
+  bool propagate(IndexG u, IndexH v) {
+    for (IndexG i=0; i<m; ++i) {
+      if (i != u) {
+        remove(i, v);
+      }
+    }
+    for (IndexH j=0; j<n; ++j) {
+      if (j != v) {
+        remove(u, j);
+      }
+    }
+    return refine();
   }
   
   bool partial_ullmann_condition(IndexG u, IndexH v) {
@@ -188,6 +226,8 @@ class ullimp_ri_state_mono {
         inv(n, m),
         h_vertices(n),
         M(m, n),
+        R(m, n),
+        consistent{true},
         index_pos_g(m),
         cutoff{static_cast<IndexG>(2)},
         level{0} {
@@ -217,19 +257,30 @@ class ullimp_ri_state_mono {
     std::iota(std::begin(h_vertices), std::end(h_vertices), 0);
     
     for (IndexG i=0; i<m; ++i) {
-      for (IndexH j=0; j<n; ++j) {
-        if (vertex_comp(i, j) &&
-            g.out_degree(i) <= h.out_degree(j) &&
-            g.in_degree(i) <= h.in_degree(j)) {
-          M.set(i, j);
-        }
-      }
+      for_each_initial_candidate(g, h, vertex_comp, i, [this, i](IndexH j) {
+        M.set(i, j);
+      });
     }
     
+    R.schedule_all();
     refine();
   }
   
-  ullimp_ri_state_mono(ullimp_ri_state_mono const &) = delete;
+ protected:
+  ullimp_ri_state_mono(ullimp_ri_state_mono const &) = default;
+  
+ public:
+  ullimp_ri_state_mono fork() const {
+    return ullimp_ri_state_mono{*this};
+  }
+
+  embedding_view<IndexG, IndexH> embedding() const {
+    return {map.data(), inv.data(), m, n};
+  }
+
+  IndexG current() const {
+    return *x_it;
+  }
 
   bool empty() {
     return x_it == std::begin(index_order_g);
@@ -245,14 +296,14 @@ class ullimp_ri_state_mono {
   void forget() {
   }
   
-  H_adjacent_vertices_container_type const & candidates() {
+  auto candidates() {
     auto x = *x_it;
     auto parent = g_parents[x].first;
     auto out = g_parents[x].second;
     if (parent != x) {
-      return out ? h.adjacent_vertices(map[parent]) : h.inv_adjacent_vertices(map[parent]);
+      return out ? vertex_range(h.adjacent_vertices(map[parent])) : vertex_range(h.inv_adjacent_vertices(map[parent]));
     } else {
-      return h_vertices;
+      return vertex_range(h_vertices);
     }
   }
 
@@ -265,6 +316,7 @@ class ullimp_ri_state_mono {
   bool assign(IndexH y) {
     auto x = *x_it;
     return
+        consistent &&
         inv[y] == m &&
         vertex_comp(x, y) &&
         M.get(x, y) &&
@@ -280,7 +332,11 @@ class ullimp_ri_state_mono {
     if (level < cutoff) {
       M.advance();
       neighborhood_filter_after(x, y);
-      partial_refine(x, y);
+      if (Refinement::incremental) {
+        consistent = propagate(x, y);
+      } else {
+        partial_refine(x, y);
+      }
     }
     
     ++x_it;
@@ -296,6 +352,7 @@ class ullimp_ri_state_mono {
     
     if (level < cutoff) {
       M.revert();
+      consistent = true;
     }
     
     map[x] = n;
@@ -311,7 +368,8 @@ template <
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate,
     typename CompatibilityMatrix,
-    typename IndexOrderG>
+    typename IndexOrderG,
+    typename Refinement>
 class ullimp_ri_state_ind
   : public ullimp_ri_state_mono<
         G,
@@ -319,7 +377,8 @@ class ullimp_ri_state_ind
         VertexEquivalencePredicate,
         EdgeEquivalencePredicate,
         CompatibilityMatrix,
-        IndexOrderG> {
+        IndexOrderG,
+        Refinement> {
  private:
   using base = ullimp_ri_state_mono<
       G,
@@ -327,7 +386,8 @@ class ullimp_ri_state_ind
       VertexEquivalencePredicate,
       EdgeEquivalencePredicate,
       CompatibilityMatrix,
-      IndexOrderG>;
+      IndexOrderG,
+      Refinement>;
       
  protected:
   using IndexG = typename base::IndexG;
@@ -341,6 +401,7 @@ class ullimp_ri_state_ind
   using base::map;
   using base::inv;
   using base::M;
+  using base::consistent;
   using base::index_pos_g;
   using base::cutoff;
   using base::level;
@@ -348,6 +409,8 @@ class ullimp_ri_state_ind
   
   using base::topology_condition;
   using base::partial_refine;
+  using base::remove;
+  using base::propagate;
   
   std::vector<IndexG> g_out_count;
   std::vector<IndexG> g_in_count;
@@ -361,14 +424,14 @@ class ullimp_ri_state_ind
     for (auto j : h.adjacent_vertices(v)) {
       if (inv[j] == m) {
         for (auto i : g.not_adjacent_vertices_after(u)) {
-          M.unset(i, j);
+          remove(i, j);
         }
       }
     }
     for (auto j : h.inv_adjacent_vertices(v)) {
       if (inv[j] == m) {
         for (auto i : g.not_inv_adjacent_vertices_after(u)) {
-          M.unset(i, j);
+          remove(i, j);
         }
       }
     } 
@@ -387,7 +450,8 @@ class ullimp_ri_state_ind
             VertexEquivalencePredicate,
             EdgeEquivalencePredicate,
             CompatibilityMatrix,
-            IndexOrderG>(g, h, vertex_comp, edge_comp, index_order_g),
+            IndexOrderG,
+            Refinement>(g, h, vertex_comp, edge_comp, index_order_g),
         g_out_count(m),
         g_in_count(m),
         h_out_count(n),
@@ -404,10 +468,19 @@ class ullimp_ri_state_ind
       });
     }
   }
+  
+ protected:
+  ullimp_ri_state_ind(ullimp_ri_state_ind const &) = default;
+  
+ public:
+  ullimp_ri_state_ind fork() const {
+    return ullimp_ri_state_ind{*this};
+  }
  
   bool assign(IndexH y) {
     auto x = *x_it;
     return
+        consistent &&
         M.get(x, y) &&
         inv[y] == m &&
         vertex_comp(x, y) &&
@@ -430,7 +503,11 @@ class ullimp_ri_state_ind
     if (level < cutoff) {
       M.advance();
       neighborhood_filter_after(x, y);
-      partial_refine(x, y);
+      if (Refinement::incremental) {
+        consistent = propagate(x, y);
+      } else {
+        partial_refine(x, y);
+      }
     }
     
     ++x_it;
@@ -446,6 +523,7 @@ class ullimp_ri_state_ind
     
     if (level < cutoff) {
       M.revert();
+      consistent = true;
     }
     
     map[x] = n;
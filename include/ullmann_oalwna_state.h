@@ -2,11 +2,15 @@
 #define ULLMANN_OALWNA_STATE_H_
 
 #include <iterator>
+#include <vector>
 
 #include <boost/iterator/counting_iterator.hpp>
 #include <boost/range/iterator_range.hpp>
 #include <boost/range/adaptor/filtered.hpp>
 
+#include "embedding_view.h"
+#include "initial_candidates.h"
+
 template <
     typename G,
     typename H,
@@ -33,6 +37,9 @@ class ullmann_oalwna_state_base {
   IndexOrderG const & index_order_g;
   typename IndexOrderG::const_iterator x_it;
 
+  std::vector<IndexH> map;
+  std::vector<IndexG> inv;
+
  public:
   ullmann_oalwna_state_base(
       G const & g,
@@ -48,19 +55,27 @@ class ullmann_oalwna_state_base {
         edge_comp{edge_comp},
         M{m, n},
         index_order_g{index_order_g},
-        x_it{std::begin(index_order_g)} {
+        x_it{std::begin(index_order_g)},
+        map(m, n),
+        inv(n, m) {
     for (IndexG i=0; i<m; ++i) {
-      for (IndexH j=0; j<n; ++j) {
-        if (vertex_comp(i, j) &&
-            g.out_degree(i) <= h.out_degree(j) &&
-            g.in_degree(i) <= h.in_degree(j)) {
-          M.set(i, j);
-        }
-      }
+      for_each_initial_candidate(g, h, vertex_comp, i, [this, i](IndexH j) {
+        M.set(i, j);
+      });
     }
   }
   
-  ullmann_oalwna_state_base(ullmann_oalwna_state_base const &) = delete;
+ protected:
+  ullmann_oalwna_state_base(ullmann_oalwna_state_base const &) = default;
+  
+ public:
+  embedding_view<IndexG, IndexH> embedding() const {
+    return {map.data(), inv.data(), m, n};
+  }
+
+  IndexG current() const {
+    return *x_it;
+  }
 
   bool empty() {
     return x_it == std::begin(index_order_g);
@@ -93,11 +108,17 @@ class ullmann_oalwna_state_base {
   }
 
   void push(IndexH y) {
+    auto x = *x_it;
+    map[x] = y;
+    inv[y] = x;
     ++x_it;
   }
   
   void pop() {
     --x_it;
+    auto x = *x_it;
+    inv[map[x]] = m;
+    map[x] = n;
   }
 };
 
@@ -203,6 +224,14 @@ class ullmann_oalwna_state_mono
             IndexOrderG>(g, h, vertex_comp, edge_comp, index_order_g) {
     refine();
   }
+  
+ protected:
+  ullmann_oalwna_state_mono(ullmann_oalwna_state_mono const &) = default;
+  
+ public:
+  ullmann_oalwna_state_mono fork() const {
+    return ullmann_oalwna_state_mono{*this};
+  }
 
   bool assign(IndexH y) {
     auto x = *x_it;
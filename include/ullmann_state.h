@@ -1,19 +1,25 @@
 #ifndef ULLMANN_STATE_H_
 #define ULLMANN_STATE_H_
 
+#include <algorithm>
 #include <iterator>
+#include <vector>
 
 #include <boost/iterator/counting_iterator.hpp>
 #include <boost/range/iterator_range.hpp>
 #include <boost/range/adaptor/filtered.hpp>
 
+#include "embedding_view.h"
+#include "initial_candidates.h"
+
 template <
     typename G,
     typename H,
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate,
     typename CompatibilityMatrix,
-    typename IndexOrderG>
+    typename IndexOrderG,
+    typename Refinement>
 class ullmann_state_base {
  protected:
   using IndexG = typename G::index_type;
@@ -29,10 +35,14 @@ class ullmann_state_base {
   EdgeEquivalencePredicate edge_comp;
 
   CompatibilityMatrix M;
+  Refinement R;
 
   IndexOrderG const & index_order_g;
   typename IndexOrderG::const_iterator x_it;
 
+  std::vector<IndexH> map;
+  std::vector<IndexG> inv;
+
  public:
   ullmann_state_base(
       G const & g,
@@ -47,20 +57,29 @@ class ullmann_state_base {
         vertex_comp{vertex_comp},
         edge_comp{edge_comp},
         M(m, n),
+        R(m, n),
         index_order_g{index_order_g},
-        x_it{std::begin(index_order_g)} {
+        x_it{std::begin(index_order_g)},
+        map(m, n),
+        inv(n, m) {
     for (IndexG i=0; i<m; ++i) {
-      for (IndexH j=0; j<n; ++j) {
-        if (vertex_comp(i, j) &&
-            g.out_degree(i) <= h.out_degree(j) &&
-            g.in_degree(i) <= h.in_degree(j)) {
-          M.set(i, j);
-        }
-      }
+      for_each_initial_candidate(g, h, vertex_comp, i, [this, i](IndexH j) {
+        M.set(i, j);
+      });
     }
   }
   
-  ullmann_state_base(ullmann_state_base const &) = delete;
+ protected:
+  ullmann_state_base(ullmann_state_base const &) = default;
+  
+ public:
+  embedding_view<IndexG, IndexH> embedding() const {
+    return {map.data(), inv.data(), m, n};
+  }
+
+  IndexG current() const {
+    return *x_it;
+  }
 
   bool empty() {
     return x_it == std::begin(index_order_g);
@@ -93,11 +112,17 @@ class ullmann_state_base {
   }
 
   void push(IndexH y) {
+    auto x = *x_it;
+    map[x] = y;
+    inv[y] = x;
     ++x_it;
   }
   
   void pop() {
     --x_it;
+    auto x = *x_it;
+    inv[map[x]] = m;
+    map[x] = n;
   }
 };
 
@@ -107,7 +132,8 @@ template <
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate,
     typename CompatibilityMatrix,
-    typename IndexOrderG>
+    typename IndexOrderG,
+    typename Refinement>
 class ullmann_state_mono
   : public ullmann_state_base<
         G,
@@ -115,7 +141,8 @@ class ullmann_state_mono
         VertexEquivalencePredicate,
         EdgeEquivalencePredicate,
         CompatibilityMatrix,
-        IndexOrderG> {
+        IndexOrderG,
+        Refinement> {
  private:
   using base = ullmann_state_base<
       G,
@@ -123,7 +150,8 @@ class ullmann_state_mono
       VertexEquivalencePredicate,
       EdgeEquivalencePredicate,
       CompatibilityMatrix,
-      IndexOrderG>;
+      IndexOrderG,
+      Refinement>;
 
  protected:
   using IndexG = typename base::IndexG;
@@ -134,14 +162,43 @@ class ullmann_state_mono
   using base::g;
   using base::h;
   using base::M;
+  using base::R;
   using base::x_it;
   
+  // pairs (ii,jj) that may have used (i,j) as support; only the
+  // worklist policy asks, and it needs G and H with adjacency lists
+  template <typename F>
+  void dependents(IndexG i, IndexH j, F f) {
+    for (auto ii : g.inv_adjacent_vertices(i)) {
+      for (auto jj : h.inv_adjacent_vertices(j)) {
+        if (M.get(ii, jj)) {
+          f(ii, jj);
+        }
+      }
+    }
+    for (auto ii : g.adjacent_vertices(i)) {
+      for (auto jj : h.adjacent_vertices(j)) {
+        if (M.get(ii, jj)) {
+          f(ii, jj);
+        }
+      }
+    }
+  }
+
+  void remove(IndexG i, IndexH j) {
+    R.unset(M, i, j, [this](IndexG ii, IndexH jj, auto f) {dependents(ii, jj, f);});
+  }
+
   void filter(IndexG i, IndexH j) {
     for (IndexG ii=0; ii<m; ++ii) {
-      M.unset(ii, j);
+      if (ii != i) {
+        remove(ii, j);
+      }
     }
     for (IndexH jj=0; jj<n; ++jj) {
-      M.unset(i, jj);
+      if (jj != j) {
+        remove(i, jj);
+      }
     }
     M.set(i, j);
   }
@@ -177,22 +234,10 @@ class ullmann_state_mono
   }
   
   bool refine() {
-    bool change;
-    do {
-      change = false;
-      for (IndexG i=0; i<m; ++i) {
-        for (IndexH j=0; j<n; ++j) {
-          if (M.get(i,j) && !ullmann_condition(i, j)) {
-            M.unset(i, j);
-            if (!M.possible(i)) {
-              return false;
-            }
-            change = true;
-          }
-        }
-      }
-    } while (change);
-    return true;
+    return R.refine(
+        M,
+        [this](IndexG i, IndexH j) {return ullmann_condition(i, j);},
+        [this](IndexG i, IndexH j, auto f) {dependents(i, j, f);});
   }
   
  public:
@@ -208,10 +253,20 @@ class ullmann_state_mono
             VertexEquivalencePredicate,
             EdgeEquivalencePredicate,
             CompatibilityMatrix,
-            IndexOrderG>(g, h, vertex_comp, edge_comp, index_order_g) {
+            IndexOrderG,
+            Refinement>(g, h, vertex_comp, edge_comp, index_order_g) {
+    R.schedule_all();
     refine();
   }
   
+ protected:
+  ullmann_state_mono(ullmann_state_mono const &) = default;
+  
+ public:
+  ullmann_state_mono fork() const {
+    return ullmann_state_mono{*this};
+  }
+  
   bool assign(IndexH y) {
     auto x = *x_it;
     filter(x, y);
@@ -226,7 +281,8 @@ template <
     typename VertexEquivalencePredicate,
     typename EdgeEquivalencePredicate,
     typename CompatibilityMatrix,
-    typename IndexOrderG>
+    typename IndexOrderG,
+    typename Refinement>
 class ullmann_state_ind
   : public ullmann_state_base<
         G,
@@ -234,7 +290,8 @@ class ullmann_state_ind
         VertexEquivalencePredicate,
         EdgeEquivalencePredicate,
         CompatibilityMatrix,
-        IndexOrderG> {
+        IndexOrderG,
+        Refinement> {
  private:
   using base = ullmann_state_base<
       G,
@@ -242,7 +299,8 @@ class ullmann_state_ind
       VertexEquivalencePredicate,
       EdgeEquivalencePredicate,
       CompatibilityMatrix,
-      IndexOrderG>;
+      IndexOrderG,
+      Refinement>;
 
  protected:
   using IndexG = typename base::IndexG;
@@ -253,16 +311,96 @@ class ullmann_state_ind
   using base::g;
   using base::h;
   using base::M;
+  using base::R;
   using base::x_it;
 
+  IndexH max_out_h = 0;
+  IndexH max_in_h = 0;
+
+  std::vector<IndexH> row;
+
+  // pairs (ii,jj) that may have used (i,j) as support; only the worklist
+  // policy asks, and it needs G and H with adjacency lists. Where g has no
+  // edge, any non-edge of h in row i supports (ii,jj), so it is left
+  // unsupported only if all of row i lies in the neighbourhood of jj; such
+  // jj are neighbours of any one vertex of the row, which is checked for
+  // the rest of it.
+  template <typename F>
+  void dependents(IndexG i, IndexH j, F f) {
+    row.clear();
+    auto limit = std::max(max_out_h, max_in_h);
+    for (IndexH jj=0; jj<n && row.size()<=limit; ++jj) {
+      if (M.get(i, jj)) {
+        row.push_back(jj);
+      }
+    }
+    bool small_out = !row.empty() && row.size() <= max_out_h;
+    bool small_in = !row.empty() && row.size() <= max_in_h;
+    for (IndexG ii=0; ii<m; ++ii) {
+      if (g.edge(ii, i)) {
+        for (auto jj : h.inv_adjacent_vertices(j)) {
+          if (M.get(ii, jj)) {
+            f(ii, jj);
+          }
+        }
+      } else if (small_out) {
+        for (auto jj : h.inv_adjacent_vertices(row.front())) {
+          if (M.get(ii, jj) && std::all_of(std::begin(row), std::end(row), [this, jj](IndexH r) {return h.edge(jj, r);})) {
+            f(ii, jj);
+          }
+        }
+      }
+      if (g.edge(i, ii)) {
+        for (auto jj : h.adjacent_vertices(j)) {
+          if (M.get(ii, jj)) {
+            f(ii, jj);
+          }
+        }
+      } else if (small_in) {
+        for (auto jj : h.adjacent_vertices(row.front())) {
+          if (M.get(ii, jj) && std::all_of(std::begin(row), std::end(row), [this, jj](IndexH r) {return h.edge(r, jj);})) {
+            f(ii, jj);
+          }
+        }
+      }
+    }
+  }
+
+  void remove(IndexG i, IndexH j) {
+    R.unset(M, i, j, [this](IndexG ii, IndexH jj, auto f) {dependents(ii, jj, f);});
+  }
+
+  // Row i keeps j, which supports every pair consistent with (i,j), so the
+  // removals from row i skip dependents() and only the pairs inconsistent
+  // with (i,j) are scheduled.
   void filter(IndexG i, IndexH j) {
     for (IndexG ii=0; ii<m; ++ii) {
-      M.unset(ii, j);
+      if (ii != i) {
+        remove(ii, j);
+      }
     }
+    auto none = [](IndexG, IndexH, auto) {};
     for (IndexH jj=0; jj<n; ++jj) {
-      M.unset(i, jj);
+      if (jj != j) {
+        R.unset(M, i, jj, none);
+      }
     }
     M.set(i, j);
+    if constexpr (Refinement::incremental) {
+      auto visit = [this](IndexG ii, auto const & jjs) {
+        for (auto jj : jjs) {
+          if (M.get(ii, jj)) {
+            R.schedule(ii, jj);
+          }
+        }
+      };
+      for (IndexG ii=0; ii<m; ++ii) {
+        if (ii != i) {
+          visit(ii, g.edge(ii, i) ? h.not_inv_adjacent_vertices(j) : h.inv_adjacent_vertices(j));
+          visit(ii, g.edge(i, ii) ? h.not_adjacent_vertices(j) : h.adjacent_vertices(j));
+        }
+      }
+    }
   }
 
   bool ullmann_condition(IndexG i, IndexH j) {
@@ -294,22 +432,10 @@ class ullmann_state_ind
   }
   
   bool refine() {
-    bool change;
-    do {
-      change = false;
-      for (IndexG i=0; i<m; ++i) {
-        for (IndexH j=0; j<n; ++j) {
-          if (M.get(i, j) && !ullmann_condition(i, j)) {
-            M.unset(i, j);
-            if (!M.possible(i)) {
-              return false;
-            }
-            change = true;
-          }
-        }
-      }
-    } while (change);
-    return true;
+    return R.refine(
+        M,
+        [this](IndexG i, IndexH j) {return ullmann_condition(i, j);},
+        [this](IndexG i, IndexH j, auto f) {dependents(i, j, f);});
   }
 
  public:
@@ -325,10 +451,24 @@ class ullmann_state_ind
             VertexEquivalencePredicate,
             EdgeEquivalencePredicate,
             CompatibilityMatrix,
-            IndexOrderG>(g, h, vertex_comp, edge_comp, index_order_g) {
+            IndexOrderG,
+            Refinement>(g, h, vertex_comp, edge_comp, index_order_g) {
+    for (IndexH j=0; j<n; ++j) {
+      max_out_h = std::max(max_out_h, h.out_degree(j));
+      max_in_h = std::max(max_in_h, h.in_degree(j));
+    }
+    R.schedule_all();
     refine();
   }
   
+ protected:
+  ullmann_state_ind(ullmann_state_ind const &) = default;
+  
+ public:
+  ullmann_state_ind fork() const {
+    return ullmann_state_ind{*this};
+  }
+  
   bool assign(IndexH y) {
     auto x = *x_it;
     filter(x, y);
@@ -0,0 +1,207 @@
+#ifndef WORD_COMPATIBILITY_MATRIX_H_
+#define WORD_COMPATIBILITY_MATRIX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "bit_row.h"
+
+// One bit per cell in 64-byte aligned rows of 64-bit words. Changed words
+// are trailed, each at most once per level, so advance() is O(1) and
+// revert() restores only what the level touched. Changes made before the
+// first advance() cannot be reverted and are not trailed.
+template <
+    typename IndexG,
+    typename IndexH>
+class word_compatibility_matrix {
+ private:
+  IndexG const m;
+  IndexH const n;
+
+  std::size_t const stride;
+
+  bit_row_vector data;
+
+  std::vector<std::pair<std::size_t, bit_word>> trail;
+  std::vector<typename decltype(trail)::size_type> shots;
+
+  // the level that trailed each word, 0 if none still open has
+  std::vector<std::uint32_t> stamps;
+
+  void store(std::size_t w, bit_word word) {
+    if (!shots.empty() && stamps[w] != shots.size()) {
+      stamps[w] = shots.size();
+      trail.emplace_back(w, data[w]);
+    }
+    data[w] = word;
+  }
+
+ public:
+  class iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = IndexH;
+    using difference_type = std::ptrdiff_t;
+    using pointer = IndexH const *;
+    using reference = IndexH;
+
+    iterator() = default;
+    iterator(bit_word const * row, std::size_t k, std::size_t j)
+        : row{row},
+          k{k},
+          j{j} {
+    }
+
+    IndexH operator*() const {
+      return j;
+    }
+    iterator & operator++() {
+      j = bit_row_next(row, k, j+1);
+      return *this;
+    }
+    iterator operator++(int) {
+      auto it = *this;
+      ++*this;
+      return it;
+    }
+    bool operator==(iterator const & other) const {
+      return j == other.j;
+    }
+    bool operator!=(iterator const & other) const {
+      return j != other.j;
+    }
+
+   private:
+    bit_word const * row = nullptr;
+    std::size_t k = 0;
+    std::size_t j = 0;
+  };
+
+  word_compatibility_matrix(IndexG m, IndexH n)
+      : m{m},
+        n{n},
+        stride{bit_row_words(n)},
+        data(m*stride),
+        stamps(m*stride) {
+    shots.reserve(m+1);
+  }
+
+  // a copy starts with an empty trail and cannot revert past this point
+  word_compatibility_matrix(word_compatibility_matrix const & other)
+      : m{other.m},
+        n{other.n},
+        stride{other.stride},
+        data(other.data),
+        stamps(other.stamps.size()) {
+    shots.reserve(m+1);
+  }
+
+  bool get(IndexG i, IndexH j) const {
+    return bit_row_test(row(i), j);
+  }
+  void set(IndexG i, IndexH j) {
+    auto w = i*stride + j/bit_word_bits;
+    auto bit = static_cast<bit_word>(1) << (j % bit_word_bits);
+    if (!(data[w] & bit)) {
+      store(w, data[w] | bit);
+    }
+  }
+  void unset(IndexG i, IndexH j) {
+    auto w = i*stride + j/bit_word_bits;
+    auto bit = static_cast<bit_word>(1) << (j % bit_word_bits);
+    if (data[w] & bit) {
+      store(w, data[w] & ~bit);
+    }
+  }
+
+  std::size_t row_words() const {
+    return stride;
+  }
+  bit_word const * row(IndexG i) const {
+    return data.data() + i*stride;
+  }
+
+  bool possible(IndexG i) const {
+    return bit_row_any(row(i), stride);
+  }
+  IndexH num_candidates(IndexG i) const {
+    return bit_row_count(row(i), stride);
+  }
+  bool intersects(IndexG i, bit_word const * mask) const {
+    return bit_row_intersects(row(i), mask, stride);
+  }
+
+  // row i = {j}, returns whether the row changed
+  bool keep_only(IndexG i, IndexH j) {
+    auto r = row(i);
+    auto jw = j/bit_word_bits;
+    auto bit = static_cast<bit_word>(1) << (j % bit_word_bits);
+    bool changed = false;
+    for (std::size_t w=0; w<stride; ++w) {
+      auto word = w == jw ? r[w] & bit : 0;
+      if (r[w] != word) {
+        store(i*stride + w, word);
+        changed = true;
+      }
+    }
+    return changed;
+  }
+
+  // row i &= mask, returns whether the row changed
+  bool and_row(IndexG i, bit_word const * mask) {
+    auto r = row(i);
+    bool changed = false;
+    for (std::size_t w=0; w<stride; w+=bit_row_block) {
+      if (!bit_row_subset(r + w, mask + w, bit_row_block)) {
+        for (std::size_t b=w; b<w+bit_row_block; ++b) {
+          if (r[b] & ~mask[b]) {
+            store(i*stride + b, r[b] & mask[b]);
+          }
+        }
+        changed = true;
+      }
+    }
+    return changed;
+  }
+  // row i &= ~mask, returns whether the row changed
+  bool andnot_row(IndexG i, bit_word const * mask) {
+    auto r = row(i);
+    bool changed = false;
+    for (std::size_t w=0; w<stride; w+=bit_row_block) {
+      if (bit_row_intersects(r + w, mask + w, bit_row_block)) {
+        for (std::size_t b=w; b<w+bit_row_block; ++b) {
+          if (r[b] & mask[b]) {
+            store(i*stride + b, r[b] & ~mask[b]);
+          }
+        }
+        changed = true;
+      }
+    }
+    return changed;
+  }
+
+  iterator row_begin(IndexG i) const {
+    return iterator{row(i), stride, bit_row_next(row(i), stride, 0)};
+  }
+  iterator row_end(IndexG i) const {
+    return iterator{row(i), stride, stride*bit_word_bits};
+  }
+
+  void advance() {
+    shots.push_back(trail.size());
+  }
+  void revert() {
+    auto size = shots.back();
+    shots.pop_back();
+    while (trail.size() > size) {
+      data[trail.back().first] = trail.back().second;
+      stamps[trail.back().first] = 0;
+      trail.pop_back();
+    }
+  }
+};
+
+#endif  // WORD_COMPATIBILITY_MATRIX_H_
@@ -0,0 +1,48 @@
+#ifndef WORK_STEALING_QUEUE_H_
+#define WORK_STEALING_QUEUE_H_
+
+#include <deque>
+#include <mutex>
+#include <utility>
+
+template <typename T>
+class work_stealing_queue {
+ private:
+  std::deque<T> tasks;
+  mutable std::mutex mutex;
+  
+ public:
+  bool empty() const {
+    std::lock_guard<std::mutex> lock{mutex};
+    return tasks.empty();
+  }
+  
+  void push(T task) {
+    std::lock_guard<std::mutex> lock{mutex};
+    tasks.push_back(std::move(task));
+  }
+  
+  // the owner takes the most recently pushed (deepest) task
+  bool pop(T & task) {
+    std::lock_guard<std::mutex> lock{mutex};
+    if (tasks.empty()) {
+      return false;
+    }
+    task = std::move(tasks.back());
+    tasks.pop_back();
+    return true;
+  }
+  
+  // thieves take the oldest (shallowest, largest) task
+  bool steal(T & task) {
+    std::lock_guard<std::mutex> lock{mutex};
+    if (tasks.empty()) {
+      return false;
+    }
+    task = std::move(tasks.front());
+    tasks.pop_front();
+    return true;
+  }
+};
+
+#endif  // WORK_STEALING_QUEUE_H_
@@ -0,0 +1,33 @@
+#ifndef WRITE_AMALFI_H_
+#define WRITE_AMALFI_H_
+
+#include <cstdint>
+
+#include <iterator>
+#include <ostream>
+
+// Inverse of read_amalfi: the same little-endian layout with Word-wide
+// counts and ids.
+template <typename Word = uint16_t>
+void write_word(std::ostream & out, Word x) {
+  for (unsigned b=0; b<sizeof(Word); ++b) {
+    out.put(static_cast<char>((x >> (8*b)) & 0xff));
+  }
+}
+
+template <
+    typename Word = uint16_t,
+    typename G>
+void write_amalfi(std::ostream & out, G const & g) {
+  auto n = g.num_vertices();
+  write_word<Word>(out, n);
+  for (decltype(n) u=0; u<n; ++u) {
+    auto const & adj = g.adjacent_vertices(u);
+    write_word<Word>(out, std::distance(std::begin(adj), std::end(adj)));
+    for (auto v : adj) {
+      write_word<Word>(out, v);
+    }
+  }
+}
+
+#endif  // WRITE_AMALFI_H_
@@ -1,30 +1,50 @@
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <vector>
 
 #include "include/read_amalfi.h"
+#include "include/index_type.h"
 #include "include/simple_adjacency_list.h"
-#include "include/predefined.h"
+#include "include/compressed_count.h"
+
+template <typename Word>
+std::uint64_t count_embeddings(char const * g_filename, char const * h_filename, unsigned num_threads) {
+  std::ifstream g_in{g_filename,std::ios::in|std::ios::binary};
+  std::ifstream h_in{h_filename,std::ios::in|std::ios::binary};
+  std::uint64_t n = std::max(read_word<Word>(g_in), read_word<Word>(h_in));
+  g_in.seekg(0);
+  h_in.seekg(0);
+
+  std::uint64_t count = 0;
+
+  with_index_type(n, [&](auto index) {
+    using Index = decltype(index);
+    auto g = read_amalfi<simple_adjacency_list<Index>, Word>(g_in);
+    auto h = read_amalfi<simple_adjacency_list<Index>, Word>(h_in);
+
+    // the same embeddings ullimp_ind enumerates, with the tail of the
+    // pattern counted rather than searched
+    count = compressed_count_ind(
+        g,
+        h,
+        [](auto x, auto y) {return true;},
+        [](auto x0, auto x1, auto y0, auto y1) {return true;},
+        num_threads);
+  });
+
+  return count;
+}
 
 int main(int argc, char * argv[]) {
   char const * g_filename = argv[1];
   char const * h_filename = argv[2];
+  unsigned num_threads = argc > 3 ? std::atoi(argv[3]) : 1;
+  unsigned word_bits = argc > 4 ? std::atoi(argv[4]) : 16;
 
-  std::ifstream in{g_filename,std::ios::in|std::ios::binary};
-  auto g = read_amalfi<simple_adjacency_list<uint16_t>>(in);
-  in.close();
-  in.open(h_filename,std::ios::in|std::ios::binary);
-  auto h = read_amalfi<simple_adjacency_list<uint16_t>>(in);
-  in.close();
-  
-  int count = 0;
-  
-  ullimp_ind(
-      g,
-      h,
-      [&count](auto const & S) {++count; return true;},
-      [](auto x, auto y) {return true;},
-      [](auto x0, auto x1, auto y0, auto y1) {return true;});
-
-  std::cout << count << std::endl;
+  std::cout << (word_bits == 32 ?
+      count_embeddings<std::uint32_t>(g_filename, h_filename, num_threads) :
+      count_embeddings<std::uint16_t>(g_filename, h_filename, num_threads)) << std::endl;
 }